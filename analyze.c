@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "analyze.h"
+#include "set.h"
+#include "tree.h"
+
+
+/*
+ * Add the characters that can begin a match of node to first and answer
+ * whether node can succeed without consuming any input.  A rule
+ * contributes whatever analyze() has computed for it so far.
+ */
+int Node_first(Node * node, unsigned char first[])
+{
+    Node *n;
+
+    int i;
+
+    switch (node->type)
+    {
+    case Name:
+        if (!node->name.rule->rule.expression)
+            break;
+        charClassOr(first, node->name.rule->rule.first);
+        return !!(node->name.rule->rule.flags & RuleNullable);
+
+    case Dot:
+        memset(first, 255, 32);
+        return 0;
+
+    case Character:
+        charClassSet(first, (unsigned char)node->character.cValue);
+        return 0;
+
+    case String:
+        if (!node->string.rawString->length)
+            return 1;
+        RawString_first(node->string.rawString, first);
+        return 0;
+
+    case Class:
+        charClassOr(first, node->cclass.bits);
+        return 0;
+
+    case StringTable:
+        if (node->table.bits)
+            charClassOr(first, node->table.bits);
+        for (i = 0; i < node->table.value.count; ++i)
+            RawString_first(node->table.value.strings[i], first);
+        return node->table.emptyString;
+
+    case Predicate:
+        // a predicate may have side effects, so it must run even when the
+        // next character would rule out the rest of the alternative.
+        if (strcmp(node->predicate.text, "YY_BEGIN")
+            && strcmp(node->predicate.text, "YY_END"))
+            memset(first, 255, 32);
+        return 1;
+
+    case Action:
+    case PeekFor:
+    case PeekNot:
+        return 1;
+
+    case Alternate:
+        i = 0;
+        for (n = node->alternate.first; n; n = n->alternate.next)
+            i |= Node_first(n, first);
+        return i;
+
+    case Sequence:
+        for (n = node->sequence.first; n; n = n->sequence.next)
+            if (!Node_first(n, first))
+                return 0;
+        return 1;
+
+    case Query:
+        Node_first(node->query.element, first);
+        return 1;
+
+    case Star:
+        Node_first(node->star.element, first);
+        return 1;
+
+    case Plus:
+        return Node_first(node->plus.element, first);
+    }
+
+    // an undefined rule (or anything unexpected) might match anything.
+    memset(first, 255, 32);
+    return 1;
+}
+
+/*
+ * Answer whether matching node might push thunks (or otherwise depend on
+ * yythunkpos), in which case backtracking over it must restore
+ * yythunkpos as well as yypos.  A rule contributes whatever analyze()
+ * has computed for it so far.
+ */
+int Node_thunks(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        return node->name.variable || !node->name.rule->rule.expression
+            || (node->name.rule->rule.flags & RuleThunks);
+
+    case Dot:
+    case Character:
+    case String:
+    case Class:
+    case StringTable:
+        return 0;
+
+    case Action:
+        return 1;
+
+    case Predicate:
+        // arbitrary code might call yyDo() or YYACCEPT.
+        return strcmp(node->predicate.text, "YY_BEGIN")
+            && strcmp(node->predicate.text, "YY_END");
+
+    case Alternate:
+        for (n = node->alternate.first; n; n = n->alternate.next)
+            if (Node_thunks(n))
+                return 1;
+        return 0;
+
+    case Sequence:
+        for (n = node->sequence.first; n; n = n->sequence.next)
+            if (Node_thunks(n))
+                return 1;
+        return 0;
+
+    case PeekFor:
+        return Node_thunks(node->peekFor.element);
+
+    case PeekNot:
+        return Node_thunks(node->peekNot.element);
+
+    case Query:
+        return Node_thunks(node->query.element);
+
+    case Star:
+        return Node_thunks(node->star.element);
+
+    case Plus:
+        return Node_thunks(node->plus.element);
+    }
+
+    return 1;
+}
+
+/*
+ * Answer whether matching node might run a predicate other than < and >,
+ * which could have side effects.  A rule contributes whatever analyze()
+ * has computed for it so far.
+ */
+int Node_predicates(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        return !!(node->name.rule->rule.flags & RulePredicates);
+
+    case Predicate:
+        return strcmp(node->predicate.text, "YY_BEGIN")
+            && strcmp(node->predicate.text, "YY_END");
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            if (Node_predicates(n))
+                return 1;
+        return 0;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_predicates(node->query.element);
+    }
+    return 0;
+}
+
+/*
+ * Answer whether node always succeeds.  A rule contributes whatever
+ * analyze() has computed for it so far.
+ */
+static int Node_infallible(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        return !!(node->name.rule->rule.flags & RuleInfallible);
+
+    case String:
+        return !node->string.rawString->length;
+
+    case Predicate:
+        // YY_BEGIN and YY_END set a text marker and are always true.
+        return !Node_thunks(node);
+
+    case Action:
+    case Query:
+    case Star:
+        return 1;
+
+    case Alternate:
+        for (n = node->alternate.first; n; n = n->alternate.next)
+            if (Node_infallible(n))
+                return 1;
+        return 0;
+
+    case Sequence:
+        for (n = node->sequence.first; n; n = n->sequence.next)
+            if (!Node_infallible(n))
+                return 0;
+        return 1;
+
+    case PeekFor:
+    case Plus:
+        return Node_infallible(node->query.element);
+    }
+    return 0;
+}
+
+/*
+ * Answer whether node leaves yypos and yythunkpos as it found them when
+ * it succeeds.
+ */
+int Node_stateless(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case String:
+        return !node->string.rawString->length;
+
+    case Predicate:
+        return !Node_thunks(node);
+
+    case PeekFor:
+    case PeekNot:
+        return 1;
+
+    case Sequence:
+        for (n = node->sequence.first; n; n = n->sequence.next)
+            if (!Node_stateless(n))
+                return 0;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Answer whether node leaves yypos and yythunkpos as it found them
+ * whenever it fails, so that nothing need be restored when backtracking
+ * over its failure.  Rules restore both before returning failure, as do
+ * the generated tests and match functions for literals.
+ */
+int Node_failsClean(Node * node)
+{
+    Node *n;
+
+    int stateless = 1;
+
+    switch (node->type)
+    {
+    case Name:
+        return !!node->name.rule->rule.expression;
+
+    case Dot:
+    case Character:
+    case String:
+    case Class:
+    case StringTable:
+    case Action:
+    case PeekNot:
+    case Query:
+    case Star:
+        return 1;
+
+    case Predicate:
+        return !Node_thunks(node);
+
+    case Alternate:
+        // the earlier alternatives are backtracked over; the last is not.
+        return Node_failsClean(node->alternate.last);
+
+    case Sequence:
+        // an element may only fail once everything before it has changed
+        // nothing.
+        for (n = node->sequence.first; n; n = n->sequence.next)
+        {
+            if (!Node_infallible(n) && !(stateless && Node_failsClean(n)))
+                return 0;
+            stateless = stateless && Node_stateless(n);
+        }
+        return 1;
+
+    case PeekFor:
+        return Node_failsClean(node->peekFor.element);
+
+    case Plus:
+        return Node_failsClean(node->plus.element);
+    }
+    return 0;
+}
+
+static int grow(Node * rule, int flag, int value)
+{
+    if (!value || (rule->rule.flags & flag))
+        return 0;
+    rule->rule.flags |= flag;
+    return 1;
+}
+
+/*
+ * Compute the FIRST set, nullability, infallibility and thunk and
+ * predicate use of every rule, so that nothing needs to follow a call
+ * into another rule to find them.  All only ever grow, so start from
+ * nothing and iterate over the rules until none changes.  Rewriting the
+ * grammar can make the results more precise, so the optimizer analyzes
+ * the rules before it starts and the code generator again afterwards.
+ */
+void analyze(Node * rules)
+{
+    Node *n;
+
+    int changed;
+
+    for (n = rules; n; n = n->rule.next)
+    {
+        n->rule.flags &= ~(RuleNullable | RuleThunks | RuleInfallible | RulePredicates);
+        memset(n->rule.first, 0, 32);
+    }
+    do
+    {
+        changed = 0;
+        for (n = rules; n; n = n->rule.next)
+        {
+            unsigned char first[32];
+
+            if (!n->rule.expression)
+                continue;
+            memcpy(first, n->rule.first, 32);
+            changed |= grow(n, RuleNullable, Node_first(n->rule.expression, first));
+            changed |= grow(n, RuleThunks, n->rule.variables || Node_thunks(n->rule.expression));
+            changed |= grow(n, RuleInfallible, Node_infallible(n->rule.expression));
+            changed |= grow(n, RulePredicates, Node_predicates(n->rule.expression));
+            if (memcmp(first, n->rule.first, 32))
+            {
+                memcpy(n->rule.first, first, 32);
+                changed = 1;
+            }
+        }
+    } while (changed);
+}
+
+/*
+ * Left recursion: a rule that can call itself again before consuming any
+ * input never returns.  The rules that each rule calls at its starting
+ * position (through alternatives, options, repetitions, predicates and
+ * any nullable elements that begin a sequence) form a graph, and a rule
+ * is left recursive when it lies on a cycle of that graph.  The strongly
+ * connected components are found in one walk (Tarjan's algorithm), using
+ * the nullability computed by analyze(), so the cost is linear in the
+ * size of the grammar.
+ */
+
+static struct
+{
+    int index, low, onStack, recursive;
+} *walk;
+
+static Node **stack;
+
+static int depth, visits;
+
+static void strongConnect(Node * rule);
+
+static void leftCalls(Node * node, Node * rule)
+{
+    Node *n, *callee;
+
+    unsigned char first[32];
+
+    switch (node->type)
+    {
+    case Name:
+        callee = node->name.rule;
+        if (!callee->rule.expression)
+            break;
+        if (callee == rule)
+            walk[rule->rule.id].recursive = 1;
+        else if (!walk[callee->rule.id].index)
+        {
+            strongConnect(callee);
+            if (walk[callee->rule.id].low < walk[rule->rule.id].low)
+                walk[rule->rule.id].low = walk[callee->rule.id].low;
+        }
+        else if (walk[callee->rule.id].onStack
+                 && walk[callee->rule.id].index < walk[rule->rule.id].low)
+            walk[rule->rule.id].low = walk[callee->rule.id].index;
+        break;
+
+    case Alternate:
+        for (n = node->alternate.first; n; n = n->any.next)
+            leftCalls(n, rule);
+        break;
+
+    case Sequence:
+        for (n = node->sequence.first; n; n = n->any.next)
+        {
+            leftCalls(n, rule);
+            if (!Node_first(n, first))
+                break;
+        }
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        leftCalls(node->query.element, rule);
+        break;
+    }
+}
+
+static void strongConnect(Node * rule)
+{
+    int id = rule->rule.id, size = 0;
+
+    Node *member;
+
+    walk[id].index = walk[id].low = ++visits;
+    walk[id].onStack = 1;
+    stack[depth++] = rule;
+    leftCalls(rule->rule.expression, rule);
+    if (walk[id].low != walk[id].index)
+        return;
+    do
+    {
+        member = stack[--depth];
+        walk[member->rule.id].onStack = 0;
+        ++size;
+    } while (member != rule);
+    if (size > 1)
+        while (size--)
+            walk[stack[depth + size]->rule.id].recursive = 1;
+}
+
+void checkLeftRecursion(Node * rules)
+{
+    Node *n;
+
+    walk = calloc(ruleCount + 1, sizeof(*walk));
+    stack = malloc((ruleCount + 1) * sizeof(Node *));
+    depth = visits = 0;
+    for (n = rules; n; n = n->rule.next)
+        if (n->rule.expression && !walk[n->rule.id].index)
+            strongConnect(n);
+    for (n = rules; n; n = n->rule.next)
+        if (walk[n->rule.id].recursive)
+            fprintf(stderr, "possible infinite left recursion in rule '%s'\n",
+                    n->rule.name);
+    free(stack);
+    free(walk);
+}
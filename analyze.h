@@ -0,0 +1,20 @@
+#ifndef __ANALYZE_H__
+#define __ANALYZE_H__
+
+union Node;
+
+void analyze(union Node *rules);
+
+void checkLeftRecursion(union Node *rules);
+
+int Node_first(union Node *node, unsigned char first[]);
+
+int Node_thunks(union Node *node);
+
+int Node_predicates(union Node *node);
+
+int Node_stateless(union Node *node);
+
+int Node_failsClean(union Node *node);
+
+#endif
@@ -26,6 +26,16 @@
 #include "tree.h"
 #include "set.h"
 #include "optimize.h"
+#include "analyze.h"
+
+int memoizeFlag = 0;
+
+int reentrantFlag = 0;
+
+int profileFlag = 0;
+
+// the rule being compiled, to which backtracking is charged.
+static int profileRule = 0;
 
 static int yyl(void)
 {
@@ -55,257 +65,953 @@ static void jump(int n)
     fprintf(output, "  goto l%d;", n);
 }
 
-static void save(int n)
+/*
+ * Backtracking over something that cannot push thunks (see Node_thunks)
+ * need only restore yypos, so yythunkpos is saved only when asked for.
+ * A restore must be passed the same thunks as its save.
+ */
+static void save(int n, int thunks)
 {
-    fprintf(output, "  int yypos%d= yypos, yythunkpos%d= yythunkpos;", n, n);
+    if (thunks)
+        fprintf(output, "  int yypos%d= yypos, yythunkpos%d= yythunkpos;", n, n);
+    else
+        fprintf(output, "  int yypos%d= yypos;", n);
 }
 
-static void restore(int n)
+static void restore(int n, int thunks)
 {
-    fprintf(output, "  yypos= yypos%d; yythunkpos= yythunkpos%d;", n, n);
+    if (profileFlag)
+        fprintf(output, "  yyprofiles[%d].backtracked += yypos - yypos%d;", profileRule, n);
+    if (thunks)
+        fprintf(output, "  yypos= yypos%d; yythunkpos= yythunkpos%d;", n, n);
+    else
+        fprintf(output, "  yypos= yypos%d;", n);
 }
 
 
-void StringTable_compile_c_ok(Node * node, int ko)
+/*
+ * A repetition of a single dot, character or class is matched by one
+ * call to a span function, which consumes the whole run and returns its
+ * length, instead of by a loop around the element.
+ */
+static int isSpan(Node * node)
 {
-    extern char *escape(const char *cp, int length);
-    //extern int STcompare(const void *, const void *);
-    extern void STsort(struct StringArray *array);
+    if (!optimizeEnabled(OptSpan))
+        return 0;
+    return Dot == node->type || Character == node->type || Class == node->type;
+}
 
+static void Node_compile_c_span(Node * node)
+{
+    switch (node->type)
+    {
+    case Dot:
+        fprintf(output, "yyspanDot(YY_CTX_ARG)");
+        break;
 
-    unsigned char *bits;
-    struct StringArray *entry;
-    struct StringArray *last;
+    case Character:
+        fprintf(output, "yyspanChar(YY_CTX_ARG_ '%s')", node->character.value);
+        break;
 
-    int re_fail, re_done;
+    case Class:
+        fprintf(output, "yyspanClass(YY_CTX_ARG_ (unsigned char *)\"%s\")",
+                charClassToNibbleString(node->cclass.bits));
+        break;
 
-    assert(node);
-    assert(node->type == StringTable);
+    default:
+        fprintf(stderr, "\ninternal error #2\n");
+        exit(1);
+    }
+}
+
+static void printChar(int c)
+{
+    if (isprint(c) && '\'' != c && '\\' != c)
+        fprintf(output, "'%c'", c);
+    else
+        fprintf(output, "0x%02x", c);
+}
+
+/*
+ * If node is a literal (a character, string or class, a choice between
+ * literals, or the name of a rule that is one) that cannot match the
+ * empty string, add the characters that can begin it to first and
+ * answer true.
+ */
+static int literalFirst(Node * node, unsigned char first[], int depth)
+{
+    switch (node->type)
+    {
+    case Name:
+        return !node->name.variable && depth < 8 && node->name.rule->rule.expression
+            && literalFirst(node->name.rule->rule.expression, first, depth + 1);
+
+    case Character:
+        charClassSet(first, (unsigned char)node->character.cValue);
+        return 1;
+
+    case String:
+        if (!node->string.rawString->length)
+            return 0;
+        RawString_first(node->string.rawString, first);
+        return 1;
+
+    case Class:
+        charClassOr(first, node->cclass.bits);
+        return 1;
+
+    case StringTable:
+    {
+        int i;
+
+        if (node->table.emptyString)
+            return 0;
+        if (node->table.bits)
+            charClassOr(first, node->table.bits);
+        for (i = 0; i < node->table.value.count; ++i)
+            RawString_first(node->table.value.strings[i], first);
+    }
+        return 1;
+
+    case Alternate:
+        for (node = node->alternate.first; node; node = node->alternate.next)
+            if (!literalFirst(node, first, depth))
+                return 0;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Is node ( !X . )* with a literal X?  If so, answer X and the set of
+ * characters that can begin it.
+ */
+static Node *scanUntil(Node * node, unsigned char first[])
+{
+    Node *peek;
+
+    if (Star != node->type || !optimizeEnabled(OptScan))
+        return 0;
+    node = node->star.element;
+    if (Sequence != node->type || !(peek = node->sequence.first)
+        || PeekNot != peek->type || !peek->any.next || Dot != peek->any.next->type
+        || peek->any.next->any.next)
+        return 0;
+    memset(first, 0, 32);
+    if (!literalFirst(peek->peekNot.element, first, 0))
+        return 0;
+    return peek->peekNot.element;
+}
+
+static void Node_compile_c_ko(Node * node, int ko);
+
+/*
+ * Emit ( !X . )* as a search: skip every character that cannot begin X
+ * (with memchr when only one can) and only try X where one might.
+ */
+static void Node_compile_c_scan(Node * node, unsigned char first[])
+{
+    int again = yyl(), miss = yyl(), out = yyl(), c, count = 0, only = 0;
+
+    int thunks = Node_thunks(node);
+
+    for (c = 0; c < 256; ++c)
+        if (charClassIsSet(first, c))
+            ++count, only = c;
+    label(again);
+    if (1 == count)
+    {
+        fprintf(output, "  yyscanChar(YY_CTX_ARG_ ");
+        printChar(only);
+        fprintf(output, ");");
+    }
+    else
+    {
+        unsigned char skip[32];
 
-    // only first entry can have character class
-    bits = node->table.bits;
-    last = entry = &node->table.value;
-
-
-    /*
-     * first entry could have a character class, too.
-     *
-     * generate something like:
-     *
-     * if (!yyrefill()) return 0;
-     * switch(yybuf[yypos++])
-     * { 
-     *    case 'a': yyrmarker = yypos; yyraccept = 1; goto re_yy_%d;
-     *    case 'b': goto re_yy_%d
-     *    default: goto yy_fail%d;
-     *  }
-     */
-
-    re_fail = yyl();
-    re_done = yyl();
-
-
-    // yythunkpos will never be updated within this code, 
-    // so it doesn't need to be saved
-    
-    // TODO -- case-insensitive option.
-    
+        for (c = 0; c < 32; ++c)
+            skip[c] = ~first[c];
+        fprintf(output, "  yyspanClass(YY_CTX_ARG_ (unsigned char *)\"%s\");",
+                charClassToNibbleString(skip));
+    }
     begin();
-    // empty strings match w/o any input.
-    fprintf(output, "\n  int yyrmarker = yypos, yyraccept = %d;\n", node->table.emptyString);
-    
-    while (entry)
-    {
-        struct StringArray *nextEntry;
-
-        int count = entry->count;
-        int offset = entry->offset;
-
-        int i, j;
-
-        if (entry->label)
-            label(entry->label);
-            
-        fprintf(output, "\n  if (yypos >= yylimit && !yyrefill())");
-        jump(re_fail);
-        
-        fprintf(output, "\n  switch(yybuf[yypos++])");
-        begin();                // {
-        fprintf(output, "\n");
+    save(miss, thunks);
+    Node_compile_c_ko(node, miss);
+    restore(miss, thunks);
+    jump(out);
+    label(miss);
+    if (!Node_failsClean(node))
+        restore(miss, thunks);
+    end();
+    fprintf(output, "  if (!yymatchDot(YY_CTX_ARG))");
+    jump(out);
+    jump(again);
+    label(out);
+}
 
-        for (i = 0; i < count; )
-        {
-           
-            char *string;
+/*
+ * Classes that cannot be tested with a few range comparisons share
+ * 256-entry lookup tables, one bit column per distinct class.
+ */
+#define MAXRANGES	3
 
-            int length;
-            char c;
+static struct ClassTable
+{
+    unsigned char bits[32];
+} *classTables = 0;
 
-            string = entry->strings[i]->string;
-            length = entry->strings[i]->length - offset;
-            
-            c = string[offset];
+static int classTableCount = 0;
 
-            // length should never be 0.
-            assert(length != 0);
-            
+static int charClassRanges(unsigned char bits[], int set, int ranges[][2])
+{
+    int c, count = 0;
 
-            if ((c & 0x80) == 0 && isalnum(c))
-                fprintf(output, "  case '%c':\n", c);
-            else
-                fprintf(output, "  case 0x%02x:\n", c);
+    for (c = 0; c < 256; ++c)
+    {
+        if (!charClassIsSet(bits, c) != !set)
+            continue;
+        if (count && ranges[count - 1][1] == c - 1)
+            ranges[count - 1][1] = c;
+        else
+        {
+            if (count == MAXRANGES)
+                return count + 1;
+            ranges[count][0] = ranges[count][1] = c;
+            ++count;
+        }
+    }
+    return count;
+}
 
+static int classTable(unsigned char bits[])
+{
+    int i;
 
-            // if bits & bit is set, then accept current state.
-            if (bits && charClassIsSet(bits, c))
-            {
-                fprintf(output, "    yyrmarker=yypos; yyraccept=1;");
-                charClassClear(bits, c);
-            }
+    for (i = 0; i < classTableCount; ++i)
+        if (!memcmp(classTables[i].bits, bits, 32))
+            return i;
+    return -1;
+}
 
-            // count up how many strings have the same character.
-            // if only 1, just do a string match.
-            // if > 1, generate a new entry and push it for later.
-            
-            // since these are sorted, only the first entry can have a length of 1.
-            // (and longest match wins since they preceeded shorter matches or were optimized out)
-            for (j = i + 1; j < count; ++j)
+static void Node_collect_classes(Node * node)
+{
+    int ranges[MAXRANGES][2];
+
+    for (; node; node = node->any.next)
+    {
+        switch (node->type)
+        {
+        case Class:
+            if (optimizeEnabled(OptClassTests)
+                && charClassRanges(node->cclass.bits, 1, ranges) > MAXRANGES
+                && charClassRanges(node->cclass.bits, 0, ranges) > MAXRANGES
+                && classTable(node->cclass.bits) < 0)
             {
-                struct RawString *rs = entry->strings[j];
-                int length = rs->length - offset;
-                if (length < 1) break; 
-                if (rs->string[offset] != c) break;
+                classTables = realloc(classTables, sizeof(struct ClassTable) * (classTableCount + 1));
+                memcpy(classTables[classTableCount++].bits, node->cclass.bits, 32);
             }
-            // j is 1 greater than the last index.
-            j -= i; // convert to count (1-based)
-            
-            if (j == 1)
-            {
-                // only 1 string, so it can be matched here 
-                // (either accept if it's 1 char or do a string match)
-                if (length == 1)
-                {
-                    jump(re_done);
-                    fputc('\n', output);
-                }
-                else
-                {
-                    char *s = escape(string + offset + 1, length - 1);
+            break;
 
-                    fprintf(output, "    if (yymatchString(\"%s\"))", s);
-                    jump(re_done);
-                    jump(re_fail);
-                    fputc('\n', output);
-                    free(s);
-                }
+        case Alternate:
+            Node_collect_classes(node->alternate.first);
+            break;
 
-                i++;
-                continue;
-            }
-            else
-            {
-                // TODO -- check for common substring, use yystringmatch
-                // instead of multiple switches
-                // eg "good" / "goodbye" -> "g" -> "ood" -> "bye"
-                struct StringArray *e;                
+        case Sequence:
+            Node_collect_classes(node->sequence.first);
+            break;
 
-                if (length == 1)
-                {
-                    // single character, can be accepted now, don't need to pass
-                    // to next level.
-                    fprintf(output, "    yyrmarker=yypos; yyraccept=1;\n");
+        case PeekFor:
+            Node_collect_classes(node->peekFor.element);
+            break;
 
-                    i++;
-                    j--;
-                }
+        case PeekNot:
+            Node_collect_classes(node->peekNot.element);
+            break;
 
-                e = (struct StringArray *)calloc(sizeof(struct StringArray) + j * sizeof(struct RawString *), 1);
-                e->count = j;
-                e->offset = offset + 1;
-                e->label = yyl();
-                
+        case Query:
+            Node_collect_classes(node->query.element);
+            break;
 
-                // these are stored backwards, but no matter
-                // since they'll be sorted and there's no
-                // reason to believe either way is faster.                
-                while (j)
-                {
-                    e->strings[--j] = entry->strings[i++];
-                }
+        case Star:
+            if (!isSpan(node->star.element))
+                Node_collect_classes(node->star.element);
+            break;
+
+        case Plus:
+            if (!isSpan(node->plus.element))
+                Node_collect_classes(node->plus.element);
+            break;
+        }
+    }
+}
 
-                // sort.
-                
-                STsort(e);
+/*
+ * Actions are generated only when a rule that has a function schedules
+ * them.  An inlined copy schedules the action of the rule it came from,
+ * which may since have been merged or removed.
+ */
+static char *actionsUsed = 0;
 
-                last->next = e;
-                last = e;
+static void Node_collect_actions(Node * node)
+{
+    for (; node; node = node->any.next)
+    {
+        switch (node->type)
+        {
+        case Action:
+            actionsUsed[node->action.id] = 1;
+            break;
+
+        case Alternate:
+        case Sequence:
+            Node_collect_actions(node->alternate.first);
+            break;
+
+        case PeekFor:
+        case PeekNot:
+        case Query:
+        case Star:
+        case Plus:
+            Node_collect_actions(node->query.element);
+            break;
+        }
+    }
+}
 
-                jump(e->label);
-                fputc('\n', output);
-            }
+static void Class_compile_c_tables(void)
+{
+    int t, c;
 
+    for (t = 0; t < classTableCount; t += 8)
+    {
+        fprintf(output, "static const unsigned char yyclasses%d[256]= {", t / 8);
+        for (c = 0; c < 256; ++c)
+        {
+            int i, column = 0;
 
+            for (i = t; i < classTableCount && i < t + 8; ++i)
+                if (charClassIsSet(classTables[i].bits, c))
+                    column |= 1 << (i - t);
+            fprintf(output, "%s0x%02x,", (c % 16) ? " " : "\n  ", column);
         }
-        if (bits)
+        fprintf(output, "\n};\n");
+    }
+    if (classTableCount)
+        fprintf(output, "\n");
+}
+
+/*
+ * Emit a test of the unsigned character yyc against the class: range
+ * comparisons against the class or its complement if either is small,
+ * otherwise a bit from one of the shared tables.
+ */
+static void Class_compile_c_test(unsigned char bits[])
+{
+    int ranges[MAXRANGES][2], count, set = 1, i;
+
+    if ((count = charClassRanges(bits, 1, ranges)) > MAXRANGES)
+    {
+        set = 0;
+        if ((count = charClassRanges(bits, 0, ranges)) > MAXRANGES)
         {
-            int c;
+            i = classTable(bits);
+            assert(i >= 0);
+            fprintf(output, "yyclasses%d[yyc] & %d", i / 8, 1 << (i % 8));
+            return;
+        }
+    }
+    if (!count)
+    {
+        fprintf(output, "%d", !set);
+        return;
+    }
+    if (!set)
+        fprintf(output, "!(");
+    for (i = 0; i < count; ++i)
+    {
+        if (i)
+            fprintf(output, " || ");
+        if (ranges[i][0] == ranges[i][1])
+        {
+            fprintf(output, "yyc == ");
+            printChar(ranges[i][0]);
+        }
+        else
+        {
+            fprintf(output, "(yyc >= ");
+            printChar(ranges[i][0]);
+            fprintf(output, " && yyc <= ");
+            printChar(ranges[i][1]);
+            fprintf(output, ")");
+        }
+    }
+    if (!set)
+        fprintf(output, ")");
+}
 
-            int hasCC;
+/*
+ * A run of adjacent characters, strings, classes and dots has a fixed
+ * length: one check that enough input is available, then a test of
+ * each byte (or a memcmp() for a long string), then a single advance.
+ */
+#define MAXBYTETESTS	8
 
-            // character class mapping.  Any common characters
-            // were handled (and cleared) above.
+static int runLength(Node * node)
+{
+    switch (node->type)
+    {
+    case Dot:
+    case Character:
+        return 1;
 
-            for (c = 0; c < 256; ++c)
-            {
-                if (charClassIsSet(bits, c))
-                {
-                    hasCC = 1;
-                    if ((c & 0x80) == 0 && isalnum(c))
-                        fprintf(output, "  case '%c':\n", c);
-                    else
-                        fprintf(output, "  case 0x%02x:\n", c);
+    case Class:
+        // without the class tests a large class has no table to test against
+        return optimizeEnabled(OptClassTests);
 
-                }
-            }
-            if (hasCC)
-            {
-                fprintf(output, "    ");
-                jump(re_done);
-                fputc('\n', output);
-            }
+    case String:
+        return node->string.rawString->length;
+    }
+    return 0;
+}
+
+/*
+ * Answer the node after the run that starts at node, or node itself if
+ * the run is not worth compiling specially.
+ */
+static Node *runEnd(Node * node)
+{
+    Node *end;
+
+    int count = 0;
+
+    if (!optimizeEnabled(OptLiteralRuns))
+        return node;
+    for (end = node; end && runLength(end); end = end->any.next)
+        ++count;
+    if (count < 2 && !(count && (Character == node->type || String == node->type)))
+        return node;
+    return end;
+}
+
+/*
+ * Print a test that is true when the length bytes at offset in the
+ * buffer differ from bytes, joined to the tests printed before it.  If
+ * caseless, the letters in bytes are lower case and match either case.
+ * Answer the number of tests printed so far.
+ */
+static int Bytes_compile_c_test(const char *bytes, int length, int offset, int tests, int caseless)
+{
+    int i;
+
+    if (length > MAXBYTETESTS && !caseless)
+    {
+        char *text = escape(bytes, length);
+
+        fprintf(output, "%smemcmp(yybuf + yypos + %d, \"%s\", %d)",
+                tests++ ? " || " : "", offset, text, length);
+        free(text);
+        return tests;
+    }
+    for (i = 0; i < length; ++i)
+    {
+        if (caseless && isalpha((unsigned char)bytes[i]))
+            fprintf(output, "%s((unsigned char)yybuf[yypos + %d] | 0x20) != ", tests++ ? " || " : "", offset + i);
+        else
+            fprintf(output, "%s(unsigned char)yybuf[yypos + %d] != ", tests++ ? " || " : "", offset + i);
+        printChar((unsigned char)bytes[i]);
+    }
+    return tests;
+}
+
+static void Literal_compile_c_call(Node * node, int ko)
+{
+    if (Character == node->type)
+        fprintf(output, "  if (!yymatchChar(YY_CTX_ARG_ '%s')) goto l%d;",
+                node->character.value, ko);
+    else if (node->string.rawString->caseless)
+        fprintf(output, "  if (!yymatchCaselessString(YY_CTX_ARG_ \"%s\")) goto l%d;",
+                node->string.value, ko);
+    else
+        fprintf(output, "  if (!yymatchString(YY_CTX_ARG_ \"%s\")) goto l%d;",
+                node->string.value, ko);
+}
 
-            bits = NULL;
+static void Node_compile_c_run(Node * node, Node * stop, int ko)
+{
+    Node *n;
+
+    int length = 0, offset = 0, tests = 0, classes = 0;
+
+    for (n = node; n != stop; n = n->any.next)
+    {
+        length += runLength(n);
+        classes += Class == n->type;
+    }
+    if (1 == length)
+    {
+        fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l%d;", ko);
+        begin();
+    }
+    else
+    {
+        fprintf(output, "  if (yylimit - yypos >= %d)", length);
+        begin();
+    }
+    fprintf(output, classes ? "  int yyc;  if (" : "  if (");
+    for (n = node; n != stop; offset += runLength(n), n = n->any.next)
+    {
+        switch (n->type)
+        {
+        case Character:
+            fprintf(output, "%s(unsigned char)yybuf[yypos + %d] != ", tests++ ? " || " : "", offset);
+            printChar((unsigned char)n->character.cValue);
+            break;
+
+        case String:
+            tests = Bytes_compile_c_test(n->string.rawString->string, n->string.rawString->length,
+                                         offset, tests, n->string.rawString->caseless);
+            break;
+
+        case Class:
+            fprintf(output, "%s(yyc= (unsigned char)yybuf[yypos + %d], !(",
+                    tests++ ? " || " : "", offset);
+            Class_compile_c_test(n->cclass.bits);
+            fprintf(output, "))");
+            break;
         }
+    }
+    if (!tests)
+        fprintf(output, "0");
+    fprintf(output, ") goto l%d;  yypos += %d;", ko, length);
+    end();
+    if (1 == length)
+        return;
+
+    // near the end of the input: match one element at a time, so that no
+    // more input is read than that would read
+    fprintf(output, "\n  else");
+    begin();
+    for (n = node; n != stop; n = n->any.next)
+        if (Character == n->type || String == n->type)
+            Literal_compile_c_call(n, ko);
+        else
+            Node_compile_c_ko(n, ko);
+    end();
+}
 
-        fprintf(output, "  default:");
-        jump(re_fail);
-        end();                  // }
+/*
+ * A string table matches the longest of its strings (or of the single
+ * characters in its class) that the input starts with; the strings that
+ * an earlier, shorter alternative would hide have already been removed.
+ * The strings are put in a trie.  A path through the trie on which no
+ * string ends and nothing branches is matched with one comparison of
+ * all its bytes, and each branch with a switch on the next character.
+ * A trie with more than STRINGTABLE_STATES nodes is matched by a loop
+ * over a transition table instead, which keeps the size of the
+ * generated code (and the time taken to compile it) down for very
+ * large sets of keywords.
+ */
+#ifndef STRINGTABLE_STATES
+#define STRINGTABLE_STATES	256
+#endif
+
+struct Trie
+{
+    struct Trie *next;          // sibling, in order of character
+    struct Trie *children;
+    int c;                      // character leading to this node
+    int accept;                 // some string ends here
+    int state;                  // number in the transition table
+};
+
+static struct Trie *Trie_new(int c)
+{
+    struct Trie *trie = (struct Trie *)calloc(1, sizeof(struct Trie));
+
+    trie->c = c;
+    return trie;
+}
 
-        // dealloc (if we allocated it)
-        nextEntry = entry->next;
+static struct Trie *Trie_child(struct Trie *trie, int c)
+{
+    struct Trie **link = &trie->children, *child;
+
+    while (*link && (*link)->c < c)
+        link = &(*link)->next;
+    if (*link && (*link)->c == c)
+        return *link;
+    child = Trie_new(c);
+    child->next = *link;
+    *link = child;
+    return child;
+}
 
-        if (entry != &node->table.value)
-            free(entry);
+static void Trie_free(struct Trie *trie)
+{
+    while (trie)
+    {
+        struct Trie *next = trie->next;
 
-        entry = nextEntry;
+        Trie_free(trie->children);
+        free(trie);
+        trie = next;
     }
+}
+
+// number the nodes depth first from 1 and answer the count
+static int Trie_number(struct Trie *trie, int state)
+{
+    struct Trie *child;
 
+    trie->state = state++;
+    for (child = trie->children; child; child = child->next)
+        state = Trie_number(child, state);
+    return state;
+}
 
-    label(re_fail);
-    fprintf(output, "  if (!yyraccept)");
-    jump(ko);
-    fprintf(output, "  yypos=yyrmarker;\n");
-    label(re_done);
-    end();                      // } 
+/*
+ * Match the bytes on the path to trie, and then whatever can follow.
+ * Every path through the generated code ends in a jump to fail or done.
+ * If caseless, the letters in the trie are lower case and match either
+ * case.
+ */
+static void Trie_compile_c(struct Trie *trie, int fail, int done, int caseless)
+{
+    struct Trie *last = trie, *child;
+
+    char bytes[1024];
+
+    int length = 0;
+
+    if (trie->accept)
+    {
+        if (!trie->children)
+        {
+            jump(done);
+            return;
+        }
+        fprintf(output, "  yyrmarker= yypos;  yyraccept= 1;");
+    }
+    while (last->children && !last->children->next && (last == trie || !last->accept)
+           && length < (int)sizeof(bytes))
+    {
+        last = last->children;
+        bytes[length++] = last->c;
+    }
+    if (1 == length)
+    {
+        fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l%d;", fail);
+        fprintf(output, "  if (");
+        Bytes_compile_c_test(bytes, length, 0, 0, caseless);
+        fprintf(output, ") goto l%d;  ++yypos;", fail);
+    }
+    else if (length)
+    {
+        char *text = escape(bytes, length);
+
+        fprintf(output, "  if (yylimit - yypos >= %d)", length);
+        begin();
+        fprintf(output, "  if (");
+        Bytes_compile_c_test(bytes, length, 0, 0, caseless);
+        fprintf(output, ") goto l%d;  yypos += %d;", fail, length);
+        end();
+        // near the end of the input: read no further than a mismatch
+        fprintf(output, "\n  else if (!yymatch%sString(YY_CTX_ARG_ \"%s\")) goto l%d;\n",
+                caseless ? "Caseless" : "", text, fail);
+        free(text);
+    }
+    if (last != trie)
+    {
+        Trie_compile_c(last, fail, done, caseless);
+        return;
+    }
+    fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l%d;", fail);
+    fprintf(output, "\n  switch ((unsigned char)yybuf[yypos++])");
+    begin();
+    fprintf(output, "\n");
+    for (child = trie->children; child; child = child->next)
+    {
+        fprintf(output, "  case ");
+        printChar(child->c);
+        fprintf(output, ":");
+        if (caseless && isalpha(child->c))
+        {
+            fprintf(output, " case ");
+            printChar(toupper(child->c));
+            fprintf(output, ":");
+        }
+        Trie_compile_c(child, fail, done, caseless);
+        fprintf(output, "\n");
+    }
+    fprintf(output, "  default:");
+    jump(fail);
+    end();
+}
+
+static void Trie_compile_c_states(struct Trie *trie, int *base)
+{
+    struct Trie *child;
+
+    int lo = 1, hi = 0;
+
+    if (trie->children)
+    {
+        lo = trie->children->c;
+        for (child = trie->children; child; child = child->next)
+            hi = child->c;
+    }
+    fprintf(output, "%s{ %d, %d, %d, %d },", (trie->state % 4) ? " " : "\n    ",
+            *base, lo, hi, trie->accept);
+    if (hi >= lo)
+        *base += hi - lo + 1;
+    for (child = trie->children; child; child = child->next)
+        Trie_compile_c_states(child, base);
+}
 
+static void Trie_compile_c_transitions(struct Trie *trie, int *count)
+{
+    struct Trie *child;
+
+    int c;
 
-    // dealloc... 
+    if (trie->children)
+    {
+        for (c = trie->children->c, child = trie->children; child; ++c)
+        {
+            fprintf(output, "%s%d,", ((*count)++ % 16) ? " " : "\n    ",
+                    c == child->c ? child->state : 0);
+            if (c == child->c)
+                child = child->next;
+        }
+    }
+    for (child = trie->children; child; child = child->next)
+        Trie_compile_c_transitions(child, count);
+}
 
+static void Trie_compile_c_table(struct Trie *trie, int fail, int caseless)
+{
+    int table = yyl(), base = 0, count = 0;
+
+    fprintf(output, "\n  static const unsigned short yytransitions%d[]= {", table);
+    Trie_compile_c_transitions(trie, &count);
+    fprintf(output, "\n  };");
+    fprintf(output, "\n  static const struct { int base;  unsigned char lo, hi, accept; } yystates%d[]= {", table);
+    fprintf(output, "\n    { 0, 1, 0, 0 },");
+    Trie_compile_c_states(trie, &base);
+    fprintf(output, "\n  };");
+    fprintf(output, "\n  int yystate= 1, yyc;");
+    fprintf(output, "\n  while (yystates%d[yystate].lo <= yystates%d[yystate].hi)", table, table);
+    begin();
+    fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) break;");
+    fprintf(output, "  yyc= (unsigned char)yybuf[yypos];");
+    if (caseless)
+        fprintf(output, "  if (yyc >= 'A' && yyc <= 'Z') yyc |= 0x20;");
+    fprintf(output, "\n    if (yyc < yystates%d[yystate].lo || yyc > yystates%d[yystate].hi", table, table);
+    fprintf(output, "\n        || !(yystate= yytransitions%d[yystates%d[yystate].base + yyc - yystates%d[yystate].lo])) break;",
+            table, table, table);
+    fprintf(output, "\n    ++yypos;  if (yystates%d[yystate].accept) yyrmarker= yypos, yyraccept= 1;", table);
+    end();
+    jump(fail);
 }
 
+static void StringTable_compile_c_ok(Node * node, int ko)
+{
+    struct StringArray *array = &node->table.value;
+
+    struct Trie *trie = Trie_new(0), *t;
+
+    int fail = yyl(), done = 0, states, i, j;
+
+    assert(node->type == StringTable);
+
+    for (i = 0; i < array->count; ++i)
+    {
+        struct RawString *string = array->strings[i];
+
+        for (t = trie, j = 0; j < string->length; ++j)
+            t = Trie_child(t, (unsigned char)string->string[j]);
+        t->accept = 1;
+    }
+    // a caseless table has both cases of any letter in its class
+    if (node->table.bits)
+        for (i = 0; i < 256; ++i)
+            if (charClassIsSet(node->table.bits, i))
+                Trie_child(trie, node->table.caseless ? tolower(i) : i)->accept = 1;
+
+    // yythunkpos is never changed by a string table, so it need not be saved
+    begin();
+    fprintf(output, "  int yyrmarker= yypos, yyraccept= %d;", node->table.emptyString);
+    states = Trie_number(trie, 1);
+    if (states - 1 > STRINGTABLE_STATES && states <= 0xffff)
+        Trie_compile_c_table(trie, fail, node->table.caseless);
+    else
+        Trie_compile_c(trie, fail, done = yyl(), node->table.caseless);
+    label(fail);
+    fprintf(output, "  yypos= yyrmarker;  if (!yyraccept)");
+    jump(ko);
+    // only the switches jump past the failure test
+    if (done)
+        label(done);
+    end();
+    Trie_free(trie);
+}
+
+/*
+ * Compile an alternate as a switch on the next character if that can
+ * tell its alternatives apart.  Alternatives whose FIRST sets overlap
+ * share a case and are tried in their original order.  One that can
+ * match the empty string is only allowed last, where it is tried
+ * whenever the others cannot match.
+ */
+static int Alternate_compile_c_switch(Node * node, int ko)
+{
+    struct Choice
+    {
+        Node *node;
+        unsigned char first[32];
+        int group;
+    } *choices;
+
+    Node *n, *fallback = 0;
+
+    int count = 0, groups = 0, i, j, k, c;
+
+    if (!optimizeEnabled(OptDispatch))
+        return 0;
+    for (n = node->alternate.first; n; n = n->alternate.next)
+        ++count;
+    choices = calloc(count, sizeof(struct Choice));
+    for (i = 0, n = node->alternate.first; n; n = n->alternate.next, ++i)
+    {
+        choices[i].node = n;
+        choices[i].group = i;
+        if (Node_first(n, choices[i].first))
+        {
+            if (n->alternate.next)
+            {
+                free(choices);
+                return 0;
+            }
+            fallback = n;
+            --count;
+        }
+    }
+
+    // merge the groups of any two alternatives that start alike.
+    for (i = 0; i < count; ++i)
+        for (j = i + 1; j < count; ++j)
+            if (choices[i].group != choices[j].group)
+            {
+                for (c = 0; c < 32; ++c)
+                    if (choices[i].first[c] & choices[j].first[c])
+                        break;
+                if (c < 32)
+                {
+                    // keep the lower number, which is the first member.
+                    int to = choices[i].group, from = choices[j].group;
+
+                    if (from < to)
+                        to = from, from = choices[i].group;
+                    for (k = 0; k < count; ++k)
+                        if (choices[k].group == from)
+                            choices[k].group = to;
+                }
+            }
+    for (i = 0; i < count; ++i)
+        if (choices[i].group == i)
+            ++groups;
+    if (groups < 2 && !fallback)
+    {
+        free(choices);
+        return 0;
+    }
+
+    {
+        int ok = yyl(), other = yyl(), thunks = Node_thunks(node), dirty = 0;
+
+        // nothing need be restored if every choice but the fallback fails clean.
+        for (i = 0; i < count; ++i)
+            dirty |= !Node_failsClean(choices[i].node);
+        begin();
+        if (dirty)
+            save(ok, thunks);
+        fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))");
+        jump(other);
+        fprintf(output, "\n  switch ((unsigned char)yybuf[yypos])");
+        begin();
+        fprintf(output, "\n");
+        for (i = 0; i < count; ++i)
+        {
+            unsigned char first[32];
+
+            int last = -1, labels = 0;
+
+            if (choices[i].group != i)
+                continue;
+            memset(first, 0, 32);
+            for (j = i; j < count; ++j)
+                if (choices[j].group == i)
+                {
+                    charClassOr(first, choices[j].first);
+                    last = j;
+                }
+            for (c = 0; c < 256; ++c)
+                if (charClassIsSet(first, c))
+                {
+                    fprintf(output, "%s", (labels++ % 8) ? " " : "  ");
+                    fprintf(output, "case ");
+                    printChar(c);
+                    fprintf(output, ":");
+                    if (!(labels % 8))
+                        fprintf(output, "\n");
+                }
+            // an alternative that can never match has no labels.
+            if (!labels)
+                continue;
+            for (j = i; j < count; ++j)
+                if (choices[j].group == i)
+                {
+                    if (j < last)
+                    {
+                        int next = yyl();
+
+                        Node_compile_c_ko(choices[j].node, next);
+                        jump(ok);
+                        label(next);
+                        if (!Node_failsClean(choices[j].node))
+                            restore(ok, thunks);
+                    }
+                    else
+                    {
+                        Node_compile_c_ko(choices[j].node, other);
+                        jump(ok);
+                    }
+                }
+            fprintf(output, "\n");
+        }
+        fprintf(output, "  default:");
+        jump(other);
+        end();
+        label(other);
+        if (dirty)
+            restore(ok, thunks);
+        if (fallback)
+            Node_compile_c_ko(fallback, ko);
+        else
+            jump(ko);
+        end();
+        label(ok);
+    }
+    free(choices);
+    return 1;
+}
 
 static void Node_compile_c_ko(Node * node, int ko)
 {
+    unsigned char first[32];
+
+    Node *until, *n;
+
     assert(node);
     switch (node->type)
     {
@@ -315,40 +1021,51 @@ static void Node_compile_c_ko(Node * node, int ko)
         break;
 
     case Dot:
-        fprintf(output, "  if (!yymatchDot()) goto l%d;", ko);
+        fprintf(output, "  if (!yymatchDot(YY_CTX_ARG)) goto l%d;", ko);
         break;
 
     case Name:
-        fprintf(output, "  if (!yy_%s()) goto l%d;",
+        fprintf(output, "  if (!yy_%s(YY_CTX_ARG)) goto l%d;",
                 node->name.rule->rule.name, ko);
         if (node->name.variable)
-            fprintf(output, "  yyDo(yySet, %d, 0);",
+            fprintf(output, "  yyDo(YY_CTX_ARG_ yySet, %d, 0);",
                     node->name.variable->variable.offset);
         break;
 
     case Character:
-        fprintf(output, "  if (!yymatchChar('%s')) goto l%d;",
-                node->character.value, ko);
-        break;
-
     case String:
-        fprintf(output, "  if (!yymatchString(\"%s\")) goto l%d;",
-                node->string.value, ko);
+        if (optimizeEnabled(OptLiteralRuns))
+            Node_compile_c_run(node, node->any.next, ko);
+        else
+            Literal_compile_c_call(node, ko);
         break;
 
     case Class:
-        fprintf(output,
-                "  if (!yymatchClass((unsigned char *)\"%s\")) goto l%d;",
-                charClassToString(node->cclass.bits), ko);
+        if (!optimizeEnabled(OptClassTests))
+        {
+            fprintf(output,
+                    "  if (!yymatchClass(YY_CTX_ARG_ (unsigned char *)\"%s\")) goto l%d;",
+                    charClassToString(node->cclass.bits), ko);
+            break;
+        }
+        fprintf(output, "  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l%d;", ko);
+        fprintf(output, "  { int yyc= (unsigned char)yybuf[yypos];  if (!(");
+        Class_compile_c_test(node->cclass.bits);
+        fprintf(output, ")) goto l%d; }  ++yypos;", ko);
         break;
 
     case Action:
-        fprintf(output, "  yyDo(yy%s, yybegin, yyend);", node->action.name);
+        // a zero end tells yyDone() not to copy the text for this action.
+        if (node->action.usesText)
+            fprintf(output, "  yyDo(YY_CTX_ARG_ yy%s, yybegin, yyend);", node->action.name);
+        else
+            fprintf(output, "  yyDo(YY_CTX_ARG_ yy%s, 0, 0);", node->action.name);
         break;
 
     case Predicate:
-        fprintf(output, "  yyText(yybegin, yyend);  if (!(%s)) goto l%d;",
-                node->action.text, ko);
+        if (node->predicate.usesText)
+            fprintf(output, "  yyText(YY_CTX_ARG_ yybegin, yyend);");
+        fprintf(output, "  if (!(%s)) goto l%d;", node->predicate.text, ko);
         break;
 
     case Alternate:
@@ -356,12 +1073,15 @@ static void Node_compile_c_ko(Node * node, int ko)
         {
             Node_compile_c_ko(node->alternate.first, ko);
         }
-        else
+        else if (!Alternate_compile_c_switch(node, ko))
         {
-            int ok = yyl();
+            int ok = yyl(), thunks = Node_thunks(node), dirty = 0;
 
+            for (n = node->alternate.first; n->alternate.next; n = n->alternate.next)
+                dirty |= !Node_failsClean(n);
             begin();
-            save(ok);
+            if (dirty)
+                save(ok, thunks);
             for (node = node->alternate.first; node;
                  node = node->alternate.next)
                 if (node->alternate.next)
@@ -371,7 +1091,8 @@ static void Node_compile_c_ko(Node * node, int ko)
                     Node_compile_c_ko(node, next);
                     jump(ok);
                     label(next);
-                    restore(ok);
+                    if (!Node_failsClean(node))
+                        restore(ok, thunks);
                 }
                 else
                     Node_compile_c_ko(node, ko);
@@ -381,80 +1102,128 @@ static void Node_compile_c_ko(Node * node, int ko)
         break;
 
     case Sequence:
-        for (node = node->sequence.first; node; node = node->sequence.next)
-            Node_compile_c_ko(node, ko);
+        for (node = node->sequence.first; node;)
+        {
+            Node *stop = runEnd(node);
+
+            if (stop != node)
+                Node_compile_c_run(node, stop, ko);
+            else
+            {
+                Node_compile_c_ko(node, ko);
+                stop = node->sequence.next;
+            }
+            node = stop;
+        }
         break;
 
     case PeekFor:
     {
-        int ok = yyl();
+        int ok = yyl(), thunks = Node_thunks(node);
 
         begin();
-        save(ok);
+        save(ok, thunks);
         Node_compile_c_ko(node->peekFor.element, ko);
-        restore(ok);
+        restore(ok, thunks);
         end();
     }
         break;
 
     case PeekNot:
     {
-        int ok = yyl();
+        int ok = yyl(), thunks = Node_thunks(node);
 
         begin();
-        save(ok);
-        Node_compile_c_ko(node->peekFor.element, ok);
+        save(ok, thunks);
+        Node_compile_c_ko(node->peekNot.element, ok);
+        if (!Node_stateless(node->peekNot.element))
+            restore(ok, thunks);
         jump(ko);
         label(ok);
-        restore(ok);
+        if (!Node_failsClean(node->peekNot.element))
+            restore(ok, thunks);
         end();
     }
         break;
 
     case Query:
     {
-        int qko = yyl(), qok = yyl();
+        int qko = yyl(), qok = yyl(), thunks = Node_thunks(node);
+
+        int clean = Node_failsClean(node->query.element);
 
         begin();
-        save(qko);
+        if (!clean)
+            save(qko, thunks);
         Node_compile_c_ko(node->query.element, qko);
         jump(qok);
         label(qko);
-        restore(qko);
+        if (!clean)
+            restore(qko, thunks);
         end();
         label(qok);
     }
         break;
 
     case Star:
-    {
-        int again = yyl(), out = yyl();
+        if ((until = scanUntil(node, first)))
+            Node_compile_c_scan(until, first);
+        else if (isSpan(node->star.element))
+        {
+            fprintf(output, "  ");
+            Node_compile_c_span(node->star.element);
+            fprintf(output, ";");
+        }
+        else
+        {
+            int again = yyl(), out = yyl(), thunks = Node_thunks(node);
 
-        label(again);
-        begin();
-        save(out);
-        Node_compile_c_ko(node->star.element, out);
-        jump(again);
-        label(out);
-        restore(out);
-        end();
-    }
+            int clean = Node_failsClean(node->star.element);
+
+            label(again);
+            begin();
+            if (!clean)
+                save(out, thunks);
+            Node_compile_c_ko(node->star.element, out);
+            jump(again);
+            label(out);
+            if (!clean)
+                restore(out, thunks);
+            end();
+        }
         break;
 
     case Plus:
-    {
-        int again = yyl(), out = yyl();
+        if (isSpan(node->plus.element))
+        {
+            fprintf(output, "  if (!");
+            Node_compile_c_span(node->plus.element);
+            fprintf(output, ") goto l%d;", ko);
+        }
+        else
+        {
+            int again = yyl(), out = yyl(), thunks = Node_thunks(node);
 
-        Node_compile_c_ko(node->plus.element, ko);
-        label(again);
-        begin();
-        save(out);
-        Node_compile_c_ko(node->plus.element, out);
-        jump(again);
-        label(out);
-        restore(out);
-        end();
-    }
+            int clean = Node_failsClean(node->plus.element);
+
+            // one loop that remembers whether the element has matched,
+            // so that the element's code is generated only once.
+            begin();
+            fprintf(output, "  int yyplus%d= 0;", again);
+            label(again);
+            begin();
+            if (!clean)
+                save(out, thunks);
+            Node_compile_c_ko(node->plus.element, out);
+            fprintf(output, "  yyplus%d= 1;", again);
+            jump(again);
+            label(out);
+            if (!clean)
+                restore(out, thunks);
+            end();
+            fprintf(output, "  if (!yyplus%d) goto l%d;", again, ko);
+            end();
+        }
         break;
 
 
@@ -512,22 +1281,42 @@ static void Rule_compile_c2(Node * node)
 
     if (!node->rule.expression)
         fprintf(stderr, "rule '%s' used but not defined\n", node->rule.name);
+    else if ((!(RuleUsed & node->rule.flags)) && (node != start))
+        fprintf(stderr, "rule '%s' defined but not used\n",
+                node->rule.name);
+
+    if (!node->rule.expression || ((RuleInlined | RuleDead) & node->rule.flags))
+    {
+        // every call was replaced by the rule's expression, went to an
+        // identical rule, or cannot be reached
+    }
     else
     {
-        int ko = yyl(), safe;
-
-        if ((!(RuleUsed & node->rule.flags)) && (node != start))
-            fprintf(stderr, "rule '%s' defined but not used\n",
-                    node->rule.name);
+        int ko = yyl(), safe, clean, thunks = !!(RuleThunks & node->rule.flags);
 
         safe = ((Query == node->rule.expression->type)
                 || (Star == node->rule.expression->type));
 
-        fprintf(output, "\nYY_RULE(int) yy_%s()\n{", node->rule.name);
-        if (!safe)
-            save(0);
+        // a rule that fails clean can jump straight to its failure exit.
+        // YYACCEPT refers to yythunkpos0 and the variables are pushed
+        // before the expression, so both need the saved state.
+        clean = Node_failsClean(node->rule.expression) && !node->rule.variables
+            && !Node_accepts(node->rule.expression);
+
+        profileRule = node->rule.id;
+        fprintf(output, "\nYY_RULE(int) yy_%s(YY_CTX_PARAM)\n{", node->rule.name);
+        if (!safe && !clean)
+            save(0, thunks);
+        if (memoizeFlag)
+            fprintf(output,
+                    "  yymemoframe yyframe;"
+                    "  if (yyMemoEnter(YY_CTX_ARG_ &yyframe, %d)) return yyframe.result;",
+                    node->rule.id);
+        if (profileFlag)
+            fprintf(output, "  int yyprofilepos= yypos;  ++yyprofiles[%d].calls;",
+                    node->rule.id);
         if (node->rule.variables)
-            fprintf(output, "  yyDo(yyPush, %d, 0);",
+            fprintf(output, "  yyDo(YY_CTX_ARG_ yyPush, %d, 0);",
                     countVariables(node->rule.variables));
         fprintf(output, "\n  yyprintf((stderr, \"%%s\\n\", \"%s\"));",
                 node->rule.name);
@@ -536,17 +1325,30 @@ static void Rule_compile_c2(Node * node)
                 "\n  yyprintf((stderr, \"  ok   %%s @ %%s\\n\", \"%s\", yybuf+yypos));",
                 node->rule.name);
         if (node->rule.variables)
-            fprintf(output, "  yyDo(yyPop, %d, 0);",
+            fprintf(output, "  yyDo(YY_CTX_ARG_ yyPop, %d, 0);",
                     countVariables(node->rule.variables));
-        fprintf(output, "\n  return 1;");
+        if (profileFlag)
+            fprintf(output,
+                    "  ++yyprofiles[%d].succeeded;  yyprofiles[%d].consumed += yypos - yyprofilepos;",
+                    node->rule.id, node->rule.id);
+        if (memoizeFlag)
+            fprintf(output, "\n  return yyMemoLeave(YY_CTX_ARG_ &yyframe, 1);");
+        else
+            fprintf(output, "\n  return 1;");
         if (!safe)
         {
             label(ko);
-            restore(0);
+            if (profileFlag)
+                fprintf(output, "  ++yyprofiles[%d].failed;", node->rule.id);
+            if (!clean)
+                restore(0, thunks);
             fprintf(output,
                     "\n  yyprintf((stderr, \"  fail %%s @ %%s\\n\", \"%s\", yybuf+yypos));",
                     node->rule.name);
-            fprintf(output, "\n  return 0;");
+            if (memoizeFlag)
+                fprintf(output, "\n  return yyMemoLeave(YY_CTX_ARG_ &yyframe, 0);");
+            else
+                fprintf(output, "\n  return 0;");
         }
         fprintf(output, "\n}");
     }
@@ -583,12 +1385,33 @@ static char *preamble = "\
 #ifndef YYPARSEFROM\n\
 #define YYPARSEFROM	yyparsefrom\n\
 #endif\n\
+#ifndef YYRELEASE\n\
+#define YYRELEASE	yyrelease\n\
+#endif\n\
+#ifdef YY_PROFILE\n\
+#ifndef YYPROFILEDUMP\n\
+#define YYPROFILEDUMP	yyprofile_dump\n\
+#endif\n\
+#endif\n\
+#ifdef YY_BUFFER\n\
+#ifndef YYPARSEBUFFER\n\
+#define YYPARSEBUFFER	yyparsebuffer\n\
+#endif\n\
+#ifndef YYPARSEFILE\n\
+#define YYPARSEFILE	yyparsefile\n\
+#endif\n\
+#endif\n\
+#ifndef YY_READ_SIZE\n\
+#define YY_READ_SIZE	4096\n\
+#endif\n\
 #ifndef YY_INPUT\n\
-#define YY_INPUT(buf, result, max_size)			\\\n\
-  {							\\\n\
-    int yyc= getchar();					\\\n\
-    result= (EOF == yyc) ? 0 : (*(buf)= yyc, 1);	\\\n\
-    yyprintf((stderr, \"<%c>\", yyc));			\\\n\
+#define YY_INPUT(buf, result, max_size)				\\\n\
+  {								\\\n\
+    int yyc;							\\\n\
+    result= 0;							\\\n\
+    while (result < (max_size) && EOF != (yyc= getc(stdin)))	\\\n\
+      if ('\\n' == ((buf)[result++]= yyc)) break;		\\\n\
+    yyprintf((stderr, \"<%.*s>\", result, (buf)));		\\\n\
   }\n\
 #endif\n\
 #ifndef YY_BEGIN\n\
@@ -610,11 +1433,126 @@ static char *preamble = "\
 #define YY_STACK_SIZE 128\n\
 #endif\n\
 \n\
+typedef struct _yycontext yycontext;\n\
+\n\
+#ifdef YY_CTX_LOCAL\n\
+#define YY_CTX_PARAM_	yycontext *yyctx,\n\
+#define YY_CTX_PARAM	yycontext *yyctx\n\
+#define YY_CTX_ARG_	yyctx,\n\
+#define YY_CTX_ARG	yyctx\n\
+#else\n\
+#define YY_CTX_PARAM_\n\
+#define YY_CTX_PARAM	void\n\
+#define YY_CTX_ARG_\n\
+#define YY_CTX_ARG\n\
+#endif\n\
+\n\
 #ifndef YY_PART\n\
 \n\
-typedef void (*yyaction)(char *yytext, int yyleng);\n\
+#ifdef __SSE2__\n\
+#include <emmintrin.h>\n\
+#endif\n\
+#ifdef __SSSE3__\n\
+#include <tmmintrin.h>\n\
+#endif\n\
+\n\
+#ifdef YY_BUFFER\n\
+#include <fcntl.h>\n\
+#include <unistd.h>\n\
+#include <sys/mman.h>\n\
+#include <sys/stat.h>\n\
+#include <errno.h>\n\
+#include <limits.h>\n\
+#endif\n\
+\n\
+typedef void (*yyaction)(YY_CTX_PARAM_ char *yytext, int yyleng);\n\
 typedef struct _yythunk { int begin, end;  yyaction  action;  struct _yythunk *next; } yythunk;\n\
 \n\
+#ifdef YY_MEMO\n\
+typedef struct _yymemo { int rule, pos, end, begin, endtext, thunk, count; } yymemo;\n\
+typedef struct _yymemoframe { int rule, pos, thunkpos, begin, end, gen, result; } yymemoframe;\n\
+#endif\n\
+\n\
+#ifdef YY_PROFILE\n\
+typedef struct _yyprofile { unsigned long calls, succeeded, failed, consumed, backtracked;  const char *name; } yyprofile;\n\
+#endif\n\
+\n\
+#ifdef YY_CTX_LOCAL\n\
+\n\
+struct _yycontext\n\
+{\n\
+  char     *__buf;\n\
+  int       __buflen;\n\
+  int       __pos;\n\
+  int       __limit;\n\
+  char     *__text;\n\
+  int       __textlen;\n\
+  int       __begin;\n\
+  int       __end;\n\
+  int       __textmax;\n\
+  yythunk  *__thunks;\n\
+  int       __thunkslen;\n\
+  int       __thunkpos;\n\
+  YYSTYPE   __;\n\
+  YYSTYPE  *__val;\n\
+  YYSTYPE  *__vals;\n\
+  int       __valslen;\n\
+#ifdef YY_MEMO\n\
+  yymemo   *__memos;\n\
+  int       __memoslen;\n\
+  int       __memoscount;\n\
+  yythunk  *__memothunks;\n\
+  int       __memothunkslen;\n\
+  int       __memothunkpos;\n\
+  int       __memogen;\n\
+#endif\n\
+#ifdef YY_PROFILE\n\
+  yyprofile __profiles[YYRULECOUNT + 1];\n\
+#endif\n\
+#ifdef YY_BUFFER\n\
+  void     *__map;\n\
+  size_t    __maplen;\n\
+#endif\n\
+#ifdef YY_CTX_MEMBERS\n\
+  YY_CTX_MEMBERS\n\
+#endif\n\
+};\n\
+\n\
+#define yybuf		(yyctx->__buf)\n\
+#define yybuflen	(yyctx->__buflen)\n\
+#define yypos		(yyctx->__pos)\n\
+#define yylimit		(yyctx->__limit)\n\
+#define yytext		(yyctx->__text)\n\
+#define yytextlen	(yyctx->__textlen)\n\
+#define yybegin		(yyctx->__begin)\n\
+#define yyend		(yyctx->__end)\n\
+#define yytextmax	(yyctx->__textmax)\n\
+#define yythunks	(yyctx->__thunks)\n\
+#define yythunkslen	(yyctx->__thunkslen)\n\
+#define yythunkpos	(yyctx->__thunkpos)\n\
+#define yy		(yyctx->__)\n\
+#define yyval		(yyctx->__val)\n\
+#define yyvals		(yyctx->__vals)\n\
+#define yyvalslen	(yyctx->__valslen)\n\
+#ifdef YY_MEMO\n\
+#define yymemos		(yyctx->__memos)\n\
+#define yymemoslen	(yyctx->__memoslen)\n\
+#define yymemoscount	(yyctx->__memoscount)\n\
+#define yymemothunks	(yyctx->__memothunks)\n\
+#define yymemothunkslen	(yyctx->__memothunkslen)\n\
+#define yymemothunkpos	(yyctx->__memothunkpos)\n\
+#define yymemogen	(yyctx->__memogen)\n\
+#endif\n\
+#ifdef YY_PROFILE\n\
+#define yyprofiles	(yyctx->__profiles)\n\
+#endif\n\
+#ifdef YY_BUFFER\n\
+#define yymap		(yyctx->__map)\n\
+#define yymaplen	(yyctx->__maplen)\n\
+#endif\n\
+\n\
+#else /* !YY_CTX_LOCAL */\n\
+\n\
 YY_VARIABLE(char *   ) yybuf= 0;\n\
 YY_VARIABLE(int	     ) yybuflen= 0;\n\
 YY_VARIABLE(int	     ) yypos= 0;\n\
@@ -631,31 +1569,58 @@ YY_VARIABLE(YYSTYPE  ) yy;\n\
 YY_VARIABLE(YYSTYPE *) yyval= 0;\n\
 YY_VARIABLE(YYSTYPE *) yyvals= 0;\n\
 YY_VARIABLE(int      ) yyvalslen= 0;\n\
+#ifdef YY_MEMO\n\
+YY_VARIABLE(yymemo * ) yymemos= 0;\n\
+YY_VARIABLE(int      ) yymemoslen= 0;\n\
+YY_VARIABLE(int      ) yymemoscount= 0;\n\
+YY_VARIABLE(yythunk *) yymemothunks= 0;\n\
+YY_VARIABLE(int      ) yymemothunkslen= 0;\n\
+YY_VARIABLE(int      ) yymemothunkpos= 0;\n\
+YY_VARIABLE(int      ) yymemogen= 0;\n\
+#endif\n\
+#ifdef YY_PROFILE\n\
+YY_VARIABLE(yyprofile) yyprofiles[YYRULECOUNT + 1];\n\
+#endif\n\
+#ifdef YY_BUFFER\n\
+YY_VARIABLE(void *   ) yymap= 0;\n\
+YY_VARIABLE(size_t   ) yymaplen= 0;\n\
+#endif\n\
+\n\
+#endif /* YY_CTX_LOCAL */\n\
+\n\
+#ifdef YY_BUFFER\n\
+\n\
+/* the whole input is already in yybuf[0 .. yylimit) */\n\
+#define yyrefill(ctx)	0\n\
+\n\
+#else\n\
 \n\
-YY_LOCAL(int) yyrefill(void)\n\
+YY_LOCAL(int) yyrefill(YY_CTX_PARAM)\n\
 {\n\
   int yyn;\n\
-  while (yybuflen - yypos < 512)\n\
+  while (yybuflen - yylimit <= YY_READ_SIZE)\n\
     {\n\
       yybuflen *= 2;\n\
       yybuf= realloc(yybuf, yybuflen);\n\
     }\n\
-  YY_INPUT((yybuf + yypos), yyn, (yybuflen - yypos));\n\
+  YY_INPUT((yybuf + yylimit), yyn, YY_READ_SIZE);\n\
   if (!yyn) return 0;\n\
   yylimit += yyn;\n\
   return 1;\n\
 }\n\
 \n\
-YY_LOCAL(int) yymatchDot(void)\n\
+#endif /* YY_BUFFER */\n\
+\n\
+YY_LOCAL(int) yymatchDot(YY_CTX_PARAM)\n\
 {\n\
-  if (yypos >= yylimit && !yyrefill()) return 0;\n\
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;\n\
   ++yypos;\n\
   return 1;\n\
 }\n\
 \n\
-YY_LOCAL(int) yymatchChar(int c)\n\
+YY_LOCAL(int) yymatchChar(YY_CTX_PARAM_ int c)\n\
 {\n\
-  if (yypos >= yylimit && !yyrefill()) return 0;\n\
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;\n\
   if (yybuf[yypos] == c)\n\
     {\n\
       ++yypos;\n\
@@ -666,12 +1631,16 @@ YY_LOCAL(int) yymatchChar(int c)\n\
   return 0;\n\
 }\n\
 \n\
-YY_LOCAL(int) yymatchString(char *s)\n\
+YY_LOCAL(int) yymatchString(YY_CTX_PARAM_ char *s)\n\
 {\n\
   int yysav= yypos;\n\
   while (*s)\n\
     {\n\
-      if (yypos >= yylimit && !yyrefill()) return 0;\n\
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))\n\
+	{\n\
+	  yypos= yysav;\n\
+	  return 0;\n\
+	}\n\
       if (yybuf[yypos] != *s)\n\
         {\n\
           yypos= yysav;\n\
@@ -683,11 +1652,35 @@ YY_LOCAL(int) yymatchString(char *s)\n\
   return 1;\n\
 }\n\
 \n\
-YY_LOCAL(int) yymatchClass(unsigned char *bits)\n\
+/* s is in lower case and matches letters of either case */\n\
+YY_LOCAL(int) yymatchCaselessString(YY_CTX_PARAM_ char *s)\n\
+{\n\
+  int yysav= yypos, yyc;\n\
+  while (*s)\n\
+    {\n\
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))\n\
+	{\n\
+	  yypos= yysav;\n\
+	  return 0;\n\
+	}\n\
+      yyc= (unsigned char)yybuf[yypos];\n\
+      if (yyc >= 'A' && yyc <= 'Z') yyc |= 0x20;\n\
+      if (yyc != (unsigned char)*s)\n\
+        {\n\
+          yypos= yysav;\n\
+          return 0;\n\
+        }\n\
+      ++s;\n\
+      ++yypos;\n\
+    }\n\
+  return 1;\n\
+}\n\
+\n\
+YY_LOCAL(int) yymatchClass(YY_CTX_PARAM_ unsigned char *bits)\n\
 {\n\
   int c;\n\
-  if (yypos >= yylimit && !yyrefill()) return 0;\n\
-  c= yybuf[yypos];\n\
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;\n\
+  c= (unsigned char)yybuf[yypos];\n\
   if (bits[c >> 3] & (1 << (c & 7)))\n\
     {\n\
       ++yypos;\n\
@@ -698,7 +1691,92 @@ YY_LOCAL(int) yymatchClass(unsigned char *bits)\n\
   return 0;\n\
 }\n\
 \n\
-YY_LOCAL(void) yyDo(yyaction action, int begin, int end)\n\
+/* c is in the class whose nibble table (see yyspanClass) is n */\n\
+#define yyinclass(n, c)	((n)[((c) >> 7) * 16 + ((c) & 15)] & (1 << (((c) >> 4) & 7)))\n\
+\n\
+YY_LOCAL(int) yyspanDot(YY_CTX_PARAM)\n\
+{\n\
+  int yysav= yypos;\n\
+  do yypos= yylimit;\n\
+  while (yyrefill(YY_CTX_ARG));\n\
+  return yypos - yysav;\n\
+}\n\
+\n\
+YY_LOCAL(int) yyspanChar(YY_CTX_PARAM_ int c)\n\
+{\n\
+  int yysav= yypos;\n\
+  for (;;)\n\
+    {\n\
+#ifdef __SSE2__\n\
+      __m128i yyc= _mm_set1_epi8(c);\n\
+      while (yylimit - yypos >= 16)\n\
+	{\n\
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));\n\
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(yyin, yyc)) & 0xffff;\n\
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;\n\
+	  yypos += 16;\n\
+	}\n\
+#endif\n\
+      for (;  yypos < yylimit;  ++yypos)\n\
+	if (yybuf[yypos] != c) return yypos - yysav;\n\
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;\n\
+    }\n\
+}\n\
+\n\
+YY_LOCAL(void) yyscanChar(YY_CTX_PARAM_ int c)\n\
+{\n\
+  for (;;)\n\
+    {\n\
+      char *yyp= memchr(yybuf + yypos, c, yylimit - yypos);\n\
+      if (yyp)\n\
+	{\n\
+	  yypos= yyp - yybuf;\n\
+	  return;\n\
+	}\n\
+      yypos= yylimit;\n\
+      if (!yyrefill(YY_CTX_ARG)) return;\n\
+    }\n\
+}\n\
+\n\
+/*\n\
+ * The class is given as a nibble table: bit (c >> 4) & 7 of byte\n\
+ * (c >> 7) * 16 + (c & 15) is set if c is in the class.  With SSSE3 the\n\
+ * table is indexed by the low nibbles of sixteen characters at once.\n\
+ */\n\
+YY_LOCAL(int) yyspanClass(YY_CTX_PARAM_ unsigned char *nibbles)\n\
+{\n\
+  int yysav= yypos;\n\
+  for (;;)\n\
+    {\n\
+#ifdef __SSSE3__\n\
+      __m128i yylow= _mm_loadu_si128((__m128i *)nibbles);\n\
+      __m128i yyhigh= _mm_loadu_si128((__m128i *)(nibbles + 16));\n\
+      __m128i yybits= _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);\n\
+      __m128i yymask= _mm_set1_epi8(15);\n\
+      while (yylimit - yypos >= 16)\n\
+	{\n\
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));\n\
+	  __m128i yylo= _mm_and_si128(yyin, yymask);\n\
+	  __m128i yyhi= _mm_and_si128(_mm_srli_epi16(yyin, 4), yymask);\n\
+	  __m128i yyupper= _mm_cmpgt_epi8(yyhi, _mm_set1_epi8(7));\n\
+	  __m128i yyrow= _mm_or_si128(_mm_andnot_si128(yyupper, _mm_shuffle_epi8(yylow, yylo)),\n\
+				      _mm_and_si128(yyupper, _mm_shuffle_epi8(yyhigh, yylo)));\n\
+	  __m128i yybit= _mm_shuffle_epi8(yybits, yyhi);\n\
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(yyrow, yybit), yybit)) & 0xffff;\n\
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;\n\
+	  yypos += 16;\n\
+	}\n\
+#endif\n\
+      for (;  yypos < yylimit;  ++yypos)\n\
+	{\n\
+	  int c= (unsigned char)yybuf[yypos];\n\
+	  if (!yyinclass(nibbles, c)) return yypos - yysav;\n\
+	}\n\
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;\n\
+    }\n\
+}\n\
+\n\
+YY_LOCAL(void) yyDo(YY_CTX_PARAM_ yyaction action, int begin, int end)\n\
 {\n\
   while (yythunkpos >= yythunkslen)\n\
     {\n\
@@ -711,14 +1789,14 @@ YY_LOCAL(void) yyDo(yyaction action, int begin, int end)\n\
   ++yythunkpos;\n\
 }\n\
 \n\
-YY_LOCAL(int) yyText(int begin, int end)\n\
+YY_LOCAL(int) yyText(YY_CTX_PARAM_ int begin, int end)\n\
 {\n\
   int yyleng= end - begin;\n\
   if (yyleng <= 0)\n\
     yyleng= 0;\n\
   else\n\
     {\n\
-      while (yytextlen < (yyleng - 1))\n\
+      while (yytextlen < (yyleng + 1))\n\
 	{\n\
 	  yytextlen *= 2;\n\
 	  yytext= realloc(yytext, yytextlen);\n\
@@ -729,31 +1807,128 @@ YY_LOCAL(int) yyText(int begin, int end)\n\
   return yyleng;\n\
 }\n\
 \n\
-YY_LOCAL(void) yyDone(void)\n\
+YY_LOCAL(void) yyDone(YY_CTX_PARAM)\n\
 {\n\
   int pos;\n\
   for (pos= 0;  pos < yythunkpos;  ++pos)\n\
     {\n\
       yythunk *thunk= &yythunks[pos];\n\
-      int yyleng= thunk->end ? yyText(thunk->begin, thunk->end) : thunk->begin;\n\
+      int yyleng= thunk->end ? yyText(YY_CTX_ARG_ thunk->begin, thunk->end) : thunk->begin;\n\
       yyprintf((stderr, \"DO [%d] %p %s\\n\", pos, thunk->action, yytext));\n\
-      thunk->action(yytext, yyleng);\n\
+      thunk->action(YY_CTX_ARG_ yytext, yyleng);\n\
     }\n\
   yythunkpos= 0;\n\
 }\n\
 \n\
-YY_LOCAL(void) yyCommit()\n\
+#ifdef YY_MEMO\n\
+\n\
+YY_LOCAL(yymemo *) yyMemoFind(YY_CTX_PARAM_ int rule, int pos)\n\
+{\n\
+  unsigned mask= yymemoslen - 1;\n\
+  unsigned h= ((unsigned)pos * YYRULECOUNT + rule) * 2654435761u & mask;\n\
+  while (yymemos[h].rule && (yymemos[h].rule != rule || yymemos[h].pos != pos))\n\
+    h= (h + 1) & mask;\n\
+  return &yymemos[h];\n\
+}\n\
+\n\
+YY_LOCAL(void) yyMemoGrow(YY_CTX_PARAM)\n\
+{\n\
+  yymemo *old= yymemos;\n\
+  int oldlen= yymemoslen, i;\n\
+  yymemoslen *= 2;\n\
+  yymemos= calloc(yymemoslen, sizeof(yymemo));\n\
+  for (i= 0;  i < oldlen;  ++i)\n\
+    if (old[i].rule)\n\
+      *yyMemoFind(YY_CTX_ARG_ old[i].rule, old[i].pos)= old[i];\n\
+  free(old);\n\
+}\n\
+\n\
+YY_LOCAL(void) yyMemoReset(YY_CTX_PARAM)\n\
+{\n\
+  if (yymemoscount)\n\
+    memset(yymemos, 0, sizeof(yymemo) * yymemoslen);\n\
+  yymemoscount= yymemothunkpos= 0;\n\
+  ++yymemogen;\n\
+}\n\
+\n\
+YY_LOCAL(int) yyMemoEnter(YY_CTX_PARAM_ yymemoframe *frame, int rule)\n\
+{\n\
+  yymemo *memo= yyMemoFind(YY_CTX_ARG_ rule, yypos);\n\
+  frame->rule= rule;\n\
+  frame->pos= yypos;\n\
+  frame->thunkpos= yythunkpos;\n\
+  frame->begin= yybegin;\n\
+  frame->end= yyend;\n\
+  frame->gen= yymemogen;\n\
+  if (!memo->rule) return 0;\n\
+  yyprintf((stderr, \"  memo %d @ %d -> %d\\n\", rule, yypos, memo->end));\n\
+  if ((frame->result= (memo->end >= 0)))\n\
+    {\n\
+      int i;\n\
+      for (i= 0;  i < memo->count;  ++i)\n\
+	{\n\
+	  yythunk *thunk= &yymemothunks[memo->thunk + i];\n\
+	  yyDo(YY_CTX_ARG_ thunk->action, thunk->begin, thunk->end);\n\
+	}\n\
+      if (memo->begin >= 0) yybegin= memo->begin;\n\
+      if (memo->endtext >= 0) yyend= memo->endtext;\n\
+      yypos= memo->end;\n\
+    }\n\
+  return 1;\n\
+}\n\
+\n\
+YY_LOCAL(int) yyMemoLeave(YY_CTX_PARAM_ yymemoframe *frame, int ok)\n\
+{\n\
+  yymemo *memo;\n\
+  if (frame->gen != yymemogen) return ok;\n\
+  if (2 * (yymemoscount + 1) > yymemoslen) yyMemoGrow(YY_CTX_ARG);\n\
+  memo= yyMemoFind(YY_CTX_ARG_ frame->rule, frame->pos);\n\
+  memo->rule= frame->rule;\n\
+  memo->pos= frame->pos;\n\
+  memo->end= memo->begin= memo->endtext= -1;\n\
+  memo->thunk= yymemothunkpos;\n\
+  memo->count= 0;\n\
+  ++yymemoscount;\n\
+  if (ok)\n\
+    {\n\
+      int count= yythunkpos - frame->thunkpos;\n\
+      while (yymemothunkpos + count > yymemothunkslen)\n\
+	{\n\
+	  yymemothunkslen *= 2;\n\
+	  yymemothunks= realloc(yymemothunks, sizeof(yythunk) * yymemothunkslen);\n\
+	}\n\
+      memcpy(yymemothunks + yymemothunkpos, yythunks + frame->thunkpos, sizeof(yythunk) * count);\n\
+      yymemothunkpos += count;\n\
+      memo->count= count;\n\
+      memo->end= yypos;\n\
+      if (yybegin != frame->begin) memo->begin= yybegin;\n\
+      if (yyend != frame->end) memo->endtext= yyend;\n\
+    }\n\
+  return ok;\n\
+}\n\
+\n\
+#endif /* YY_MEMO */\n\
+\n\
+YY_LOCAL(void) yyCommit(YY_CTX_PARAM)\n\
 {\n\
+#ifdef YY_BUFFER\n\
+  yybuf += yypos;\n\
+  yylimit -= yypos;\n\
+#else\n\
   if ((yylimit -= yypos))\n\
     {\n\
       memmove(yybuf, yybuf + yypos, yylimit);\n\
     }\n\
+#endif\n\
+#ifdef YY_MEMO\n\
+  yyMemoReset(YY_CTX_ARG);\n\
+#endif\n\
   yybegin -= yypos;\n\
   yyend -= yypos;\n\
   yypos= yythunkpos= 0;\n\
 }\n\
 \n\
-YY_LOCAL(int) yyAccept(int tp0)\n\
+YY_LOCAL(int) yyAccept(YY_CTX_PARAM_ int tp0)\n\
 {\n\
   if (tp0)\n\
     {\n\
@@ -762,19 +1937,19 @@ YY_LOCAL(int) yyAccept(int tp0)\n\
     }\n\
   else\n\
     {\n\
-      yyDone();\n\
-      yyCommit();\n\
+      yyDone(YY_CTX_ARG);\n\
+      yyCommit(YY_CTX_ARG);\n\
     }\n\
   return 1;\n\
 }\n\
 \n\
-YY_LOCAL(void) yyPush(char *text, int count)	{ yyval += count; }\n\
-YY_LOCAL(void) yyPop(char *text, int count)	{ yyval -= count; }\n\
-YY_LOCAL(void) yySet(char *text, int count)	{ yyval[count]= yy; }\n\
+YY_LOCAL(void) yyPush(YY_CTX_PARAM_ char *text, int count)	{ yyval += count; }\n\
+YY_LOCAL(void) yyPop(YY_CTX_PARAM_ char *text, int count)	{ yyval -= count; }\n\
+YY_LOCAL(void) yySet(YY_CTX_PARAM_ char *text, int count)	{ yyval[count]= yy; }\n\
 \n\
 #endif /* YY_PART */\n\
 \n\
-#define	YYACCEPT	yyAccept(yythunkpos0)\n\
+#define	YYACCEPT	yyAccept(YY_CTX_ARG_ yythunkpos0)\n\
 \n\
 ";
 
@@ -782,35 +1957,54 @@ static char *footer = "\n\
 \n\
 #ifndef YY_PART\n\
 \n\
-typedef int (*yyrule)();\n\
+typedef int (*yyrule)(YY_CTX_PARAM);\n\
 \n\
-YY_PARSE(int) YYPARSEFROM(yyrule yystart)\n\
+YY_PARSE(int) YYPARSEFROM(YY_CTX_PARAM_ yyrule yystart)\n\
 {\n\
   int yyok;\n\
   if (!yybuflen)\n\
     {\n\
       yybuflen= 1024;\n\
+#ifndef YY_BUFFER\n\
       yybuf= malloc(yybuflen);\n\
+#endif\n\
       yytextlen= 1024;\n\
       yytext= malloc(yytextlen);\n\
       yythunkslen= YY_STACK_SIZE;\n\
       yythunks= malloc(sizeof(yythunk) * yythunkslen);\n\
       yyvalslen= YY_STACK_SIZE;\n\
       yyvals= malloc(sizeof(YYSTYPE) * yyvalslen);\n\
+#ifdef YY_MEMO\n\
+      yymemoslen= 1024;\n\
+      yymemos= calloc(yymemoslen, sizeof(yymemo));\n\
+      yymemothunkslen= YY_STACK_SIZE;\n\
+      yymemothunks= malloc(sizeof(yythunk) * yymemothunkslen);\n\
+#endif\n\
+#ifdef YY_BUFFER\n\
+      yybegin= yyend= yythunkpos= 0;	/* yybuf, yypos and yylimit were set by YYPARSEBUFFER */\n\
+#else\n\
       yybegin= yyend= yypos= yylimit= yythunkpos= 0;\n\
+#endif\n\
     }\n\
   yybegin= yyend= yypos;\n\
   yythunkpos= 0;\n\
   yyval= yyvals;\n\
-  yyok= yystart();\n\
-  if (yyok) yyDone();\n\
-  yyCommit();\n\
+  yyok= yystart(YY_CTX_ARG);\n\
+  if (yyok) yyDone(YY_CTX_ARG);\n\
+  yyCommit(YY_CTX_ARG);\n\
   return yyok;\n\
+#ifndef YY_BUFFER\n\
   (void)yyrefill;\n\
+#endif\n\
   (void)yymatchDot;\n\
   (void)yymatchChar;\n\
   (void)yymatchString;\n\
+  (void)yymatchCaselessString;\n\
   (void)yymatchClass;\n\
+  (void)yyspanDot;\n\
+  (void)yyspanChar;\n\
+  (void)yyspanClass;\n\
+  (void)yyscanChar;\n\
   (void)yyDo;\n\
   (void)yyText;\n\
   (void)yyDone;\n\
@@ -822,9 +2016,107 @@ YY_PARSE(int) YYPARSEFROM(yyrule yystart)\n\
   (void)yytextmax;\n\
 }\n\
 \n\
-YY_PARSE(int) YYPARSE(void)\n\
+YY_PARSE(int) YYPARSE(YY_CTX_PARAM)\n\
+{\n\
+  return YYPARSEFROM(YY_CTX_ARG_ yy_%s);\n\
+}\n\
+\n\
+#ifdef YY_BUFFER\n\
+\n\
+YY_LOCAL(void) yyunmap(YY_CTX_PARAM)\n\
+{\n\
+  if (yymap)\n\
+    {\n\
+      munmap(yymap, yymaplen);\n\
+      yymap= 0;\n\
+      yymaplen= 0;\n\
+    }\n\
+}\n\
+\n\
+YY_PARSE(int) YYPARSEBUFFER(YY_CTX_PARAM_ const char *data, size_t len)\n\
+{\n\
+  if (len > INT_MAX)\n\
+    {\n\
+      errno= EOVERFLOW;\n\
+      return -1;\n\
+    }\n\
+  yybuf= (char *)data;\n\
+  yylimit= len;\n\
+  yybegin= yyend= yypos= 0;\n\
+  return YYPARSE(YY_CTX_ARG);\n\
+}\n\
+\n\
+YY_PARSE(int) YYPARSEFILE(YY_CTX_PARAM_ const char *path)\n\
+{\n\
+  struct stat st;\n\
+  void *map= 0;\n\
+  int fd;\n\
+  if ((fd= open(path, O_RDONLY)) < 0)\n\
+    return -1;\n\
+  if (fstat(fd, &st) < 0\n\
+      || (st.st_size > INT_MAX && (errno= EOVERFLOW))\n\
+      || (st.st_size && MAP_FAILED == (map= mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))))\n\
+    {\n\
+      close(fd);\n\
+      return -1;\n\
+    }\n\
+  close(fd);\n\
+  yyunmap(YY_CTX_ARG);\n\
+  yymap= map;\n\
+  yymaplen= st.st_size;\n\
+  return YYPARSEBUFFER(YY_CTX_ARG_ map ? (char *)map : \"\", st.st_size);\n\
+}\n\
+\n\
+#endif /* YY_BUFFER */\n\
+\n\
+#ifdef YY_PROFILE\n\
+\n\
+YY_LOCAL(int) yyprofilecmp(const void *a, const void *b)\n\
+{\n\
+  const yyprofile *p= a, *q= b;\n\
+  if (p->calls != q->calls) return p->calls < q->calls ? 1 : -1;\n\
+  return strcmp(p->name, q->name);\n\
+}\n\
+\n\
+YY_PARSE(void) YYPROFILEDUMP(YY_CTX_PARAM_ FILE *stream)\n\
+{\n\
+  yyprofile yyreport[YYRULECOUNT];\n\
+  int i;\n\
+  for (i= 0;  i < YYRULECOUNT;  ++i)\n\
+    {\n\
+      yyreport[i]= yyprofiles[i + 1];\n\
+      yyreport[i].name= yyrulenames[i + 1];\n\
+    }\n\
+  qsort(yyreport, YYRULECOUNT, sizeof(yyprofile), yyprofilecmp);\n\
+  fprintf(stream, \"%%12s %%12s %%12s %%14s %%14s  %%s\\n\",\n\
+	  \"calls\", \"succeeded\", \"failed\", \"consumed\", \"backtracked\", \"rule\");\n\
+  for (i= 0;  i < YYRULECOUNT && yyreport[i].calls;  ++i)\n\
+    fprintf(stream, \"%%12lu %%12lu %%12lu %%14lu %%14lu  %%s\\n\",\n\
+	    yyreport[i].calls, yyreport[i].succeeded, yyreport[i].failed,\n\
+	    yyreport[i].consumed, yyreport[i].backtracked, yyreport[i].name);\n\
+}\n\
+\n\
+#endif /* YY_PROFILE */\n\
+\n\
+YY_PARSE(void) YYRELEASE(YY_CTX_PARAM)\n\
 {\n\
-  return YYPARSEFROM(yy_%s);\n\
+#ifdef YY_BUFFER\n\
+  yyunmap(YY_CTX_ARG);\n\
+#endif\n\
+  if (yybuflen)\n\
+    {\n\
+#ifndef YY_BUFFER\n\
+      free(yybuf);\n\
+#endif\n\
+      free(yytext);\n\
+      free(yythunks);\n\
+      free(yyvals);\n\
+#ifdef YY_MEMO\n\
+      free(yymemos);\n\
+      free(yymemothunks);\n\
+#endif\n\
+      yybuflen= 0;\n\
+    }\n\
 }\n\
 \n\
 #endif\n\
@@ -838,107 +2130,48 @@ void Rule_compile_c_header(void)
     fprintf(output, "\n");
     fprintf(output, "%s", header);
     fprintf(output, "#define YYRULECOUNT %d\n", ruleCount);
+    if (memoizeFlag)
+        fprintf(output, "#define YY_MEMO 1\n");
+    if (reentrantFlag)
+        fprintf(output, "#define YY_CTX_LOCAL 1\n");
+    if (profileFlag)
+        fprintf(output, "#define YY_PROFILE 1\n");
 }
 
-int consumesInput(Node * node)
-{
-    if (!node)
-        return 0;
-
-    switch (node->type)
-    {
-    case Rule:
-    {
-        int result = 0;
-
-        if (RuleReached & node->rule.flags)
-            fprintf(stderr, "possible infinite left recursion in rule '%s'\n",
-                    node->rule.name);
-        else
-        {
-            node->rule.flags |= RuleReached;
-            result = consumesInput(node->rule.expression);
-            node->rule.flags &= ~RuleReached;
-        }
-        return result;
-    }
-        break;
-
-    case Dot:
-        return 1;
-    case Name:
-        return consumesInput(node->name.rule);
-    case Character:
-        return 1;
-    case String:
-        return strlen(node->string.value) > 0;
-    case Class:
-        return 1;
-    case Action:
-        return 0;
-    case Predicate:
-        return 0;
-
-    case Alternate:
-    {
-        Node *n;
-
-        for (n = node->alternate.first; n; n = n->alternate.next)
-            if (!consumesInput(n))
-                return 0;
-    }
-        return 1;
-
-    case Sequence:
-    {
-        Node *n;
-
-        for (n = node->alternate.first; n; n = n->alternate.next)
-            if (consumesInput(n))
-                return 1;
-    }
-        return 0;
-
-    case PeekFor:
-        return 0;
-    case PeekNot:
-        return 0;
-    case Query:
-        return 0;
-    case Star:
-        return 0;
-    case Plus:
-        return consumesInput(node->plus.element);
-
-    case StringTable:
-        return 1;
-
-    default:
-        fprintf(stderr, "\nconsumesInput: illegal node type %d\n", node->type);
-        exit(1);
-    }
-    return 0;
-}
-
-
 void Rule_compile_c(Node * node)
 {
     Node *n;
 
-    for (n = rules; n; n = n->rule.next)
-        optimize(n);
+    optimize(rules);
+    if (verboseFlag)
+        optimizeStatistics(stderr);
 
-    for (n = rules; n; n = n->rule.next)
-        consumesInput(n);
+    analyze(rules);
+    checkLeftRecursion(rules);
 
     fprintf(output, "%s", preamble);
+    for (n = rules; n; n = n->rule.next)
+        if (!(RuleDead & n->rule.flags))
+            Node_collect_classes(n->rule.expression);
+    actionsUsed = calloc(actions ? actions->action.id + 1 : 1, 1);
+    for (n = rules; n; n = n->rule.next)
+        if (n->rule.expression && !((RuleInlined | RuleDead) & n->rule.flags))
+            Node_collect_actions(n->rule.expression);
+    Class_compile_c_tables();
     for (n = node; n; n = n->rule.next)
-        fprintf(output, "YY_RULE(int) yy_%s(); /* %d */\n", n->rule.name,
-                n->rule.id);
+        if (!((RuleInlined | RuleDead) & n->rule.flags))
+            fprintf(output, "YY_RULE(int) yy_%s(YY_CTX_PARAM); /* %d */\n",
+                    n->rule.name, n->rule.id);
     fprintf(output, "\n");
+
+    // in a local context yytext is a macro; actions receive it as an argument.
+    fprintf(output, "#ifdef YY_CTX_LOCAL\n#undef yytext\n#endif\n");
     for (n = actions; n; n = n->action.list)
     {
-        fprintf(output, "YY_ACTION(void) yy%s(char *yytext, int yyleng)\n{\n",
+        if (!actionsUsed[n->action.id])
+            continue;
+        fprintf(output,
+                "YY_ACTION(void) yy%s(YY_CTX_PARAM_ char *yytext, int yyleng)\n{\n",
                 n->action.name);
         defineVariables(n->action.rule->rule.variables);
         fprintf(output, "  yyprintf((stderr, \"do yy%s\\n\"));\n",
@@ -947,6 +2180,24 @@ void Rule_compile_c(Node * node)
         undefineVariables(n->action.rule->rule.variables);
         fprintf(output, "}\n");
     }
+    free(actionsUsed);
+    actionsUsed = 0;
+    fprintf(output,
+            "#ifdef YY_CTX_LOCAL\n#define yytext\t\t(yyctx->__text)\n#endif\n");
     Rule_compile_c2(node);
+    if (profileFlag)
+    {
+        char **names = calloc(ruleCount + 1, sizeof(char *));
+
+        int i;
+
+        for (n = rules; n; n = n->rule.next)
+            names[n->rule.id] = n->rule.name;
+        fprintf(output, "\n\nstatic const char *yyrulenames[]= {\n  0,");
+        for (i = 1; i <= ruleCount; ++i)
+            fprintf(output, "\n  \"%s\",", names[i]);
+        fprintf(output, "\n};");
+        free(names);
+    }
     fprintf(output, footer, start->rule.name);
 }
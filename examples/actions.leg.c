@@ -0,0 +1,836 @@
+/* A recursive-descent parser generated by peg 0.1.2 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define YYRULECOUNT 4
+
+#include <stdio.h>
+
+#ifndef YY_VARIABLE
+#define YY_VARIABLE(T)	static T
+#endif
+#ifndef YY_LOCAL
+#define YY_LOCAL(T)	static T
+#endif
+#ifndef YY_ACTION
+#define YY_ACTION(T)	static T
+#endif
+#ifndef YY_RULE
+#define YY_RULE(T)	static T
+#endif
+#ifndef YY_PARSE
+#define YY_PARSE(T)	T
+#endif
+#ifndef YYPARSE
+#define YYPARSE		yyparse
+#endif
+#ifndef YYPARSEFROM
+#define YYPARSEFROM	yyparsefrom
+#endif
+#ifndef YYRELEASE
+#define YYRELEASE	yyrelease
+#endif
+#ifdef YY_PROFILE
+#ifndef YYPROFILEDUMP
+#define YYPROFILEDUMP	yyprofile_dump
+#endif
+#endif
+#ifdef YY_BUFFER
+#ifndef YYPARSEBUFFER
+#define YYPARSEBUFFER	yyparsebuffer
+#endif
+#ifndef YYPARSEFILE
+#define YYPARSEFILE	yyparsefile
+#endif
+#endif
+#ifndef YY_READ_SIZE
+#define YY_READ_SIZE	4096
+#endif
+#ifndef YY_INPUT
+#define YY_INPUT(buf, result, max_size)				\
+  {								\
+    int yyc;							\
+    result= 0;							\
+    while (result < (max_size) && EOF != (yyc= getc(stdin)))	\
+      if ('\n' == ((buf)[result++]= yyc)) break;		\
+    yyprintf((stderr, "<%.*s>", result, (buf)));		\
+  }
+#endif
+#ifndef YY_BEGIN
+#define YY_BEGIN	( yybegin= yypos, 1)
+#endif
+#ifndef YY_END
+#define YY_END		( yyend= yypos, 1)
+#endif
+#ifdef YY_DEBUG
+# define yyprintf(args)	fprintf args
+#else
+# define yyprintf(args)
+#endif
+#ifndef YYSTYPE
+#define YYSTYPE	int
+#endif
+
+#ifndef YY_STACK_SIZE
+#define YY_STACK_SIZE 128
+#endif
+
+typedef struct _yycontext yycontext;
+
+#ifdef YY_CTX_LOCAL
+#define YY_CTX_PARAM_	yycontext *yyctx,
+#define YY_CTX_PARAM	yycontext *yyctx
+#define YY_CTX_ARG_	yyctx,
+#define YY_CTX_ARG	yyctx
+#else
+#define YY_CTX_PARAM_
+#define YY_CTX_PARAM	void
+#define YY_CTX_ARG_
+#define YY_CTX_ARG
+#endif
+
+#ifndef YY_PART
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#ifdef YY_BUFFER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <limits.h>
+#endif
+
+typedef void (*yyaction)(YY_CTX_PARAM_ char *yytext, int yyleng);
+typedef struct _yythunk { int begin, end;  yyaction  action;  struct _yythunk *next; } yythunk;
+
+#ifdef YY_MEMO
+typedef struct _yymemo { int rule, pos, end, begin, endtext, thunk, count; } yymemo;
+typedef struct _yymemoframe { int rule, pos, thunkpos, begin, end, gen, result; } yymemoframe;
+#endif
+
+#ifdef YY_PROFILE
+typedef struct _yyprofile { unsigned long calls, succeeded, failed, consumed, backtracked;  const char *name; } yyprofile;
+#endif
+
+#ifdef YY_CTX_LOCAL
+
+struct _yycontext
+{
+  char     *__buf;
+  int       __buflen;
+  int       __pos;
+  int       __limit;
+  char     *__text;
+  int       __textlen;
+  int       __begin;
+  int       __end;
+  int       __textmax;
+  yythunk  *__thunks;
+  int       __thunkslen;
+  int       __thunkpos;
+  YYSTYPE   __;
+  YYSTYPE  *__val;
+  YYSTYPE  *__vals;
+  int       __valslen;
+#ifdef YY_MEMO
+  yymemo   *__memos;
+  int       __memoslen;
+  int       __memoscount;
+  yythunk  *__memothunks;
+  int       __memothunkslen;
+  int       __memothunkpos;
+  int       __memogen;
+#endif
+#ifdef YY_PROFILE
+  yyprofile __profiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+  void     *__map;
+  size_t    __maplen;
+#endif
+#ifdef YY_CTX_MEMBERS
+  YY_CTX_MEMBERS
+#endif
+};
+
+#define yybuf		(yyctx->__buf)
+#define yybuflen	(yyctx->__buflen)
+#define yypos		(yyctx->__pos)
+#define yylimit		(yyctx->__limit)
+#define yytext		(yyctx->__text)
+#define yytextlen	(yyctx->__textlen)
+#define yybegin		(yyctx->__begin)
+#define yyend		(yyctx->__end)
+#define yytextmax	(yyctx->__textmax)
+#define yythunks	(yyctx->__thunks)
+#define yythunkslen	(yyctx->__thunkslen)
+#define yythunkpos	(yyctx->__thunkpos)
+#define yy		(yyctx->__)
+#define yyval		(yyctx->__val)
+#define yyvals		(yyctx->__vals)
+#define yyvalslen	(yyctx->__valslen)
+#ifdef YY_MEMO
+#define yymemos		(yyctx->__memos)
+#define yymemoslen	(yyctx->__memoslen)
+#define yymemoscount	(yyctx->__memoscount)
+#define yymemothunks	(yyctx->__memothunks)
+#define yymemothunkslen	(yyctx->__memothunkslen)
+#define yymemothunkpos	(yyctx->__memothunkpos)
+#define yymemogen	(yyctx->__memogen)
+#endif
+#ifdef YY_PROFILE
+#define yyprofiles	(yyctx->__profiles)
+#endif
+#ifdef YY_BUFFER
+#define yymap		(yyctx->__map)
+#define yymaplen	(yyctx->__maplen)
+#endif
+
+#else /* !YY_CTX_LOCAL */
+
+YY_VARIABLE(char *   ) yybuf= 0;
+YY_VARIABLE(int	     ) yybuflen= 0;
+YY_VARIABLE(int	     ) yypos= 0;
+YY_VARIABLE(int	     ) yylimit= 0;
+YY_VARIABLE(char *   ) yytext= 0;
+YY_VARIABLE(int	     ) yytextlen= 0;
+YY_VARIABLE(int	     ) yybegin= 0;
+YY_VARIABLE(int	     ) yyend= 0;
+YY_VARIABLE(int	     ) yytextmax= 0;
+YY_VARIABLE(yythunk *) yythunks= 0;
+YY_VARIABLE(int	     ) yythunkslen= 0;
+YY_VARIABLE(int      ) yythunkpos= 0;
+YY_VARIABLE(YYSTYPE  ) yy;
+YY_VARIABLE(YYSTYPE *) yyval= 0;
+YY_VARIABLE(YYSTYPE *) yyvals= 0;
+YY_VARIABLE(int      ) yyvalslen= 0;
+#ifdef YY_MEMO
+YY_VARIABLE(yymemo * ) yymemos= 0;
+YY_VARIABLE(int      ) yymemoslen= 0;
+YY_VARIABLE(int      ) yymemoscount= 0;
+YY_VARIABLE(yythunk *) yymemothunks= 0;
+YY_VARIABLE(int      ) yymemothunkslen= 0;
+YY_VARIABLE(int      ) yymemothunkpos= 0;
+YY_VARIABLE(int      ) yymemogen= 0;
+#endif
+#ifdef YY_PROFILE
+YY_VARIABLE(yyprofile) yyprofiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+YY_VARIABLE(void *   ) yymap= 0;
+YY_VARIABLE(size_t   ) yymaplen= 0;
+#endif
+
+#endif /* YY_CTX_LOCAL */
+
+#ifdef YY_BUFFER
+
+/* the whole input is already in yybuf[0 .. yylimit) */
+#define yyrefill(ctx)	0
+
+#else
+
+YY_LOCAL(int) yyrefill(YY_CTX_PARAM)
+{
+  int yyn;
+  while (yybuflen - yylimit <= YY_READ_SIZE)
+    {
+      yybuflen *= 2;
+      yybuf= realloc(yybuf, yybuflen);
+    }
+  YY_INPUT((yybuf + yylimit), yyn, YY_READ_SIZE);
+  if (!yyn) return 0;
+  yylimit += yyn;
+  return 1;
+}
+
+#endif /* YY_BUFFER */
+
+YY_LOCAL(int) yymatchDot(YY_CTX_PARAM)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  ++yypos;
+  return 1;
+}
+
+YY_LOCAL(int) yymatchChar(YY_CTX_PARAM_ int c)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  if (yybuf[yypos] == c)
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+  return 0;
+}
+
+YY_LOCAL(int) yymatchString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      if (yybuf[yypos] != *s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+/* s is in lower case and matches letters of either case */
+YY_LOCAL(int) yymatchCaselessString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos, yyc;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      yyc= (unsigned char)yybuf[yypos];
+      if (yyc >= 'A' && yyc <= 'Z') yyc |= 0x20;
+      if (yyc != (unsigned char)*s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yymatchClass(YY_CTX_PARAM_ unsigned char *bits)
+{
+  int c;
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  c= (unsigned char)yybuf[yypos];
+  if (bits[c >> 3] & (1 << (c & 7)))
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchClass @ %s\n", yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchClass @ %s\n", yybuf+yypos));
+  return 0;
+}
+
+/* c is in the class whose nibble table (see yyspanClass) is n */
+#define yyinclass(n, c)	((n)[((c) >> 7) * 16 + ((c) & 15)] & (1 << (((c) >> 4) & 7)))
+
+YY_LOCAL(int) yyspanDot(YY_CTX_PARAM)
+{
+  int yysav= yypos;
+  do yypos= yylimit;
+  while (yyrefill(YY_CTX_ARG));
+  return yypos - yysav;
+}
+
+YY_LOCAL(int) yyspanChar(YY_CTX_PARAM_ int c)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSE2__
+      __m128i yyc= _mm_set1_epi8(c);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(yyin, yyc)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	if (yybuf[yypos] != c) return yypos - yysav;
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyscanChar(YY_CTX_PARAM_ int c)
+{
+  for (;;)
+    {
+      char *yyp= memchr(yybuf + yypos, c, yylimit - yypos);
+      if (yyp)
+	{
+	  yypos= yyp - yybuf;
+	  return;
+	}
+      yypos= yylimit;
+      if (!yyrefill(YY_CTX_ARG)) return;
+    }
+}
+
+/*
+ * The class is given as a nibble table: bit (c >> 4) & 7 of byte
+ * (c >> 7) * 16 + (c & 15) is set if c is in the class.  With SSSE3 the
+ * table is indexed by the low nibbles of sixteen characters at once.
+ */
+YY_LOCAL(int) yyspanClass(YY_CTX_PARAM_ unsigned char *nibbles)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSSE3__
+      __m128i yylow= _mm_loadu_si128((__m128i *)nibbles);
+      __m128i yyhigh= _mm_loadu_si128((__m128i *)(nibbles + 16));
+      __m128i yybits= _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      __m128i yymask= _mm_set1_epi8(15);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  __m128i yylo= _mm_and_si128(yyin, yymask);
+	  __m128i yyhi= _mm_and_si128(_mm_srli_epi16(yyin, 4), yymask);
+	  __m128i yyupper= _mm_cmpgt_epi8(yyhi, _mm_set1_epi8(7));
+	  __m128i yyrow= _mm_or_si128(_mm_andnot_si128(yyupper, _mm_shuffle_epi8(yylow, yylo)),
+				      _mm_and_si128(yyupper, _mm_shuffle_epi8(yyhigh, yylo)));
+	  __m128i yybit= _mm_shuffle_epi8(yybits, yyhi);
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(yyrow, yybit), yybit)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	{
+	  int c= (unsigned char)yybuf[yypos];
+	  if (!yyinclass(nibbles, c)) return yypos - yysav;
+	}
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyDo(YY_CTX_PARAM_ yyaction action, int begin, int end)
+{
+  while (yythunkpos >= yythunkslen)
+    {
+      yythunkslen *= 2;
+      yythunks= realloc(yythunks, sizeof(yythunk) * yythunkslen);
+    }
+  yythunks[yythunkpos].begin=  begin;
+  yythunks[yythunkpos].end=    end;
+  yythunks[yythunkpos].action= action;
+  ++yythunkpos;
+}
+
+YY_LOCAL(int) yyText(YY_CTX_PARAM_ int begin, int end)
+{
+  int yyleng= end - begin;
+  if (yyleng <= 0)
+    yyleng= 0;
+  else
+    {
+      while (yytextlen < (yyleng + 1))
+	{
+	  yytextlen *= 2;
+	  yytext= realloc(yytext, yytextlen);
+	}
+      memcpy(yytext, yybuf + begin, yyleng);
+    }
+  yytext[yyleng]= '\0';
+  return yyleng;
+}
+
+YY_LOCAL(void) yyDone(YY_CTX_PARAM)
+{
+  int pos;
+  for (pos= 0;  pos < yythunkpos;  ++pos)
+    {
+      yythunk *thunk= &yythunks[pos];
+      int yyleng= thunk->end ? yyText(YY_CTX_ARG_ thunk->begin, thunk->end) : thunk->begin;
+      yyprintf((stderr, "DO [%d] %p %s\n", pos, thunk->action, yytext));
+      thunk->action(YY_CTX_ARG_ yytext, yyleng);
+    }
+  yythunkpos= 0;
+}
+
+#ifdef YY_MEMO
+
+YY_LOCAL(yymemo *) yyMemoFind(YY_CTX_PARAM_ int rule, int pos)
+{
+  unsigned mask= yymemoslen - 1;
+  unsigned h= ((unsigned)pos * YYRULECOUNT + rule) * 2654435761u & mask;
+  while (yymemos[h].rule && (yymemos[h].rule != rule || yymemos[h].pos != pos))
+    h= (h + 1) & mask;
+  return &yymemos[h];
+}
+
+YY_LOCAL(void) yyMemoGrow(YY_CTX_PARAM)
+{
+  yymemo *old= yymemos;
+  int oldlen= yymemoslen, i;
+  yymemoslen *= 2;
+  yymemos= calloc(yymemoslen, sizeof(yymemo));
+  for (i= 0;  i < oldlen;  ++i)
+    if (old[i].rule)
+      *yyMemoFind(YY_CTX_ARG_ old[i].rule, old[i].pos)= old[i];
+  free(old);
+}
+
+YY_LOCAL(void) yyMemoReset(YY_CTX_PARAM)
+{
+  if (yymemoscount)
+    memset(yymemos, 0, sizeof(yymemo) * yymemoslen);
+  yymemoscount= yymemothunkpos= 0;
+  ++yymemogen;
+}
+
+YY_LOCAL(int) yyMemoEnter(YY_CTX_PARAM_ yymemoframe *frame, int rule)
+{
+  yymemo *memo= yyMemoFind(YY_CTX_ARG_ rule, yypos);
+  frame->rule= rule;
+  frame->pos= yypos;
+  frame->thunkpos= yythunkpos;
+  frame->begin= yybegin;
+  frame->end= yyend;
+  frame->gen= yymemogen;
+  if (!memo->rule) return 0;
+  yyprintf((stderr, "  memo %d @ %d -> %d\n", rule, yypos, memo->end));
+  if ((frame->result= (memo->end >= 0)))
+    {
+      int i;
+      for (i= 0;  i < memo->count;  ++i)
+	{
+	  yythunk *thunk= &yymemothunks[memo->thunk + i];
+	  yyDo(YY_CTX_ARG_ thunk->action, thunk->begin, thunk->end);
+	}
+      if (memo->begin >= 0) yybegin= memo->begin;
+      if (memo->endtext >= 0) yyend= memo->endtext;
+      yypos= memo->end;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yyMemoLeave(YY_CTX_PARAM_ yymemoframe *frame, int ok)
+{
+  yymemo *memo;
+  if (frame->gen != yymemogen) return ok;
+  if (2 * (yymemoscount + 1) > yymemoslen) yyMemoGrow(YY_CTX_ARG);
+  memo= yyMemoFind(YY_CTX_ARG_ frame->rule, frame->pos);
+  memo->rule= frame->rule;
+  memo->pos= frame->pos;
+  memo->end= memo->begin= memo->endtext= -1;
+  memo->thunk= yymemothunkpos;
+  memo->count= 0;
+  ++yymemoscount;
+  if (ok)
+    {
+      int count= yythunkpos - frame->thunkpos;
+      while (yymemothunkpos + count > yymemothunkslen)
+	{
+	  yymemothunkslen *= 2;
+	  yymemothunks= realloc(yymemothunks, sizeof(yythunk) * yymemothunkslen);
+	}
+      memcpy(yymemothunks + yymemothunkpos, yythunks + frame->thunkpos, sizeof(yythunk) * count);
+      yymemothunkpos += count;
+      memo->count= count;
+      memo->end= yypos;
+      if (yybegin != frame->begin) memo->begin= yybegin;
+      if (yyend != frame->end) memo->endtext= yyend;
+    }
+  return ok;
+}
+
+#endif /* YY_MEMO */
+
+YY_LOCAL(void) yyCommit(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yybuf += yypos;
+  yylimit -= yypos;
+#else
+  if ((yylimit -= yypos))
+    {
+      memmove(yybuf, yybuf + yypos, yylimit);
+    }
+#endif
+#ifdef YY_MEMO
+  yyMemoReset(YY_CTX_ARG);
+#endif
+  yybegin -= yypos;
+  yyend -= yypos;
+  yypos= yythunkpos= 0;
+}
+
+YY_LOCAL(int) yyAccept(YY_CTX_PARAM_ int tp0)
+{
+  if (tp0)
+    {
+      fprintf(stderr, "accept denied at %d\n", tp0);
+      return 0;
+    }
+  else
+    {
+      yyDone(YY_CTX_ARG);
+      yyCommit(YY_CTX_ARG);
+    }
+  return 1;
+}
+
+YY_LOCAL(void) yyPush(YY_CTX_PARAM_ char *text, int count)	{ yyval += count; }
+YY_LOCAL(void) yyPop(YY_CTX_PARAM_ char *text, int count)	{ yyval -= count; }
+YY_LOCAL(void) yySet(YY_CTX_PARAM_ char *text, int count)	{ yyval[count]= yy; }
+
+#endif /* YY_PART */
+
+#define	YYACCEPT	yyAccept(YY_CTX_ARG_ yythunkpos0)
+
+YY_RULE(int) yy_z(YY_CTX_PARAM); /* 4 */
+YY_RULE(int) yy_y(YY_CTX_PARAM); /* 3 */
+YY_RULE(int) yy_start(YY_CTX_PARAM); /* 1 */
+
+#ifdef YY_CTX_LOCAL
+#undef yytext
+#endif
+YY_ACTION(void) yy_1_z(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define v yyval[-1]
+  yyprintf((stderr, "do yy_1_z\n"));
+   printf("%d\n", v + 1); ;
+#undef v
+}
+YY_ACTION(void) yy_1_x(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_x\n"));
+   yy = 1;  printf("x\n"); ;
+}
+YY_ACTION(void) yy_1_start(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define v yyval[-1]
+  yyprintf((stderr, "do yy_1_start\n"));
+   printf("%d\n", v); ;
+#undef v
+}
+#ifdef YY_CTX_LOCAL
+#define yytext		(yyctx->__text)
+#endif
+
+YY_RULE(int) yy_z(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "z"));  if (!yy_y(YY_CTX_ARG)) goto l1;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_z, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "z", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l1:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "z", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_y(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "y"));  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l2;
+  {  if ((unsigned char)yybuf[yypos + 0] != 'a') goto l2;  yypos += 1;
+  }  yyDo(YY_CTX_ARG_ yy_1_x, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "y", yybuf+yypos));
+  return 1;
+  l2:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "y", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_start(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "start"));
+  {  int yypos4= yypos, yythunkpos4= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l3;
+  {  if ((unsigned char)yybuf[yypos + 0] != 'a') goto l3;  yypos += 1;
+  }  yyDo(YY_CTX_ARG_ yy_1_x, 0, 0);  yypos= yypos4; yythunkpos= yythunkpos4;
+  }  if (!yy_y(YY_CTX_ARG)) goto l3;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  if (!yy_z(YY_CTX_ARG)) goto l3;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l3;
+  {  if ((unsigned char)yybuf[yypos + 0] != 0x0a) goto l3;  yypos += 1;
+  }  yyDo(YY_CTX_ARG_ yy_1_start, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "start", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l3:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "start", yybuf+yypos));
+  return 0;
+}
+
+#ifndef YY_PART
+
+typedef int (*yyrule)(YY_CTX_PARAM);
+
+YY_PARSE(int) YYPARSEFROM(YY_CTX_PARAM_ yyrule yystart)
+{
+  int yyok;
+  if (!yybuflen)
+    {
+      yybuflen= 1024;
+#ifndef YY_BUFFER
+      yybuf= malloc(yybuflen);
+#endif
+      yytextlen= 1024;
+      yytext= malloc(yytextlen);
+      yythunkslen= YY_STACK_SIZE;
+      yythunks= malloc(sizeof(yythunk) * yythunkslen);
+      yyvalslen= YY_STACK_SIZE;
+      yyvals= malloc(sizeof(YYSTYPE) * yyvalslen);
+#ifdef YY_MEMO
+      yymemoslen= 1024;
+      yymemos= calloc(yymemoslen, sizeof(yymemo));
+      yymemothunkslen= YY_STACK_SIZE;
+      yymemothunks= malloc(sizeof(yythunk) * yymemothunkslen);
+#endif
+#ifdef YY_BUFFER
+      yybegin= yyend= yythunkpos= 0;	/* yybuf, yypos and yylimit were set by YYPARSEBUFFER */
+#else
+      yybegin= yyend= yypos= yylimit= yythunkpos= 0;
+#endif
+    }
+  yybegin= yyend= yypos;
+  yythunkpos= 0;
+  yyval= yyvals;
+  yyok= yystart(YY_CTX_ARG);
+  if (yyok) yyDone(YY_CTX_ARG);
+  yyCommit(YY_CTX_ARG);
+  return yyok;
+#ifndef YY_BUFFER
+  (void)yyrefill;
+#endif
+  (void)yymatchDot;
+  (void)yymatchChar;
+  (void)yymatchString;
+  (void)yymatchCaselessString;
+  (void)yymatchClass;
+  (void)yyspanDot;
+  (void)yyspanChar;
+  (void)yyspanClass;
+  (void)yyscanChar;
+  (void)yyDo;
+  (void)yyText;
+  (void)yyDone;
+  (void)yyCommit;
+  (void)yyAccept;
+  (void)yyPush;
+  (void)yyPop;
+  (void)yySet;
+  (void)yytextmax;
+}
+
+YY_PARSE(int) YYPARSE(YY_CTX_PARAM)
+{
+  return YYPARSEFROM(YY_CTX_ARG_ yy_start);
+}
+
+#ifdef YY_BUFFER
+
+YY_LOCAL(void) yyunmap(YY_CTX_PARAM)
+{
+  if (yymap)
+    {
+      munmap(yymap, yymaplen);
+      yymap= 0;
+      yymaplen= 0;
+    }
+}
+
+YY_PARSE(int) YYPARSEBUFFER(YY_CTX_PARAM_ const char *data, size_t len)
+{
+  if (len > INT_MAX)
+    {
+      errno= EOVERFLOW;
+      return -1;
+    }
+  yybuf= (char *)data;
+  yylimit= len;
+  yybegin= yyend= yypos= 0;
+  return YYPARSE(YY_CTX_ARG);
+}
+
+YY_PARSE(int) YYPARSEFILE(YY_CTX_PARAM_ const char *path)
+{
+  struct stat st;
+  void *map= 0;
+  int fd;
+  if ((fd= open(path, O_RDONLY)) < 0)
+    return -1;
+  if (fstat(fd, &st) < 0
+      || (st.st_size > INT_MAX && (errno= EOVERFLOW))
+      || (st.st_size && MAP_FAILED == (map= mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))))
+    {
+      close(fd);
+      return -1;
+    }
+  close(fd);
+  yyunmap(YY_CTX_ARG);
+  yymap= map;
+  yymaplen= st.st_size;
+  return YYPARSEBUFFER(YY_CTX_ARG_ map ? (char *)map : "", st.st_size);
+}
+
+#endif /* YY_BUFFER */
+
+#ifdef YY_PROFILE
+
+YY_LOCAL(int) yyprofilecmp(const void *a, const void *b)
+{
+  const yyprofile *p= a, *q= b;
+  if (p->calls != q->calls) return p->calls < q->calls ? 1 : -1;
+  return strcmp(p->name, q->name);
+}
+
+YY_PARSE(void) YYPROFILEDUMP(YY_CTX_PARAM_ FILE *stream)
+{
+  yyprofile yyreport[YYRULECOUNT];
+  int i;
+  for (i= 0;  i < YYRULECOUNT;  ++i)
+    {
+      yyreport[i]= yyprofiles[i + 1];
+      yyreport[i].name= yyrulenames[i + 1];
+    }
+  qsort(yyreport, YYRULECOUNT, sizeof(yyprofile), yyprofilecmp);
+  fprintf(stream, "%12s %12s %12s %14s %14s  %s\n",
+	  "calls", "succeeded", "failed", "consumed", "backtracked", "rule");
+  for (i= 0;  i < YYRULECOUNT && yyreport[i].calls;  ++i)
+    fprintf(stream, "%12lu %12lu %12lu %14lu %14lu  %s\n",
+	    yyreport[i].calls, yyreport[i].succeeded, yyreport[i].failed,
+	    yyreport[i].consumed, yyreport[i].backtracked, yyreport[i].name);
+}
+
+#endif /* YY_PROFILE */
+
+YY_PARSE(void) YYRELEASE(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yyunmap(YY_CTX_ARG);
+#endif
+  if (yybuflen)
+    {
+#ifndef YY_BUFFER
+      free(yybuf);
+#endif
+      free(yytext);
+      free(yythunks);
+      free(yyvals);
+#ifdef YY_MEMO
+      free(yymemos);
+      free(yymemothunks);
+#endif
+      yybuflen= 0;
+    }
+}
+
+#endif
+
+
+int main()
+{
+  while (yyparse());
+
+  return 0;
+}
+
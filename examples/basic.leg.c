@@ -0,0 +1,1987 @@
+/* A recursive-descent parser generated by peg 0.1.2 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define YYRULECOUNT 22
+
+# include <stdio.h>
+
+  typedef struct line line;
+
+  struct line
+  {
+    int	  number;
+    int	  length;
+    char *text;
+  };
+
+  line *lines= 0;
+  int   numLines= 0;
+  int   pc= -1, epc= -1;
+  int   batch= 0;
+
+  int nextLine(char *buf, int max);
+
+# define min(x, y) ((x) < (y) ? (x) : (y))
+
+# define YY_INPUT(buf, result, max_size)	\
+  {						\
+    if ((pc >= 0) && (pc < numLines))		\
+      {						\
+        line *linep= lines+pc++;		\
+        result= min(max_size, linep->length);	\
+        memcpy(buf, linep->text, result);	\
+      }						\
+    else					\
+      result= nextLine(buf, max_size);		\
+  }
+
+  union value {
+    int		  number;
+    char	 *string;
+    int		(*binop)(int lhs, int rhs);
+  };
+
+# define YYSTYPE union value
+
+  int variables[26];
+
+  void accept(int number, char *line);
+
+  void save(char *name);
+  void load(char *name);
+  void type(char *name);
+
+  int lessThan(int lhs, int rhs)	{ return lhs <  rhs; }
+  int lessEqual(int lhs, int rhs)	{ return lhs <= rhs; }
+  int notEqual(int lhs, int rhs)	{ return lhs != rhs; }
+  int equalTo(int lhs, int rhs)		{ return lhs == rhs; }
+  int greaterEqual(int lhs, int rhs)	{ return lhs >= rhs; }
+  int greaterThan(int lhs, int rhs)	{ return lhs >  rhs; }
+
+  int input(void);
+
+  int stack[1024], sp= 0;
+
+  char *help;
+
+  void error(char *fmt, ...);
+
+#ifndef YY_VARIABLE
+#define YY_VARIABLE(T)	static T
+#endif
+#ifndef YY_LOCAL
+#define YY_LOCAL(T)	static T
+#endif
+#ifndef YY_ACTION
+#define YY_ACTION(T)	static T
+#endif
+#ifndef YY_RULE
+#define YY_RULE(T)	static T
+#endif
+#ifndef YY_PARSE
+#define YY_PARSE(T)	T
+#endif
+#ifndef YYPARSE
+#define YYPARSE		yyparse
+#endif
+#ifndef YYPARSEFROM
+#define YYPARSEFROM	yyparsefrom
+#endif
+#ifndef YYRELEASE
+#define YYRELEASE	yyrelease
+#endif
+#ifdef YY_PROFILE
+#ifndef YYPROFILEDUMP
+#define YYPROFILEDUMP	yyprofile_dump
+#endif
+#endif
+#ifdef YY_BUFFER
+#ifndef YYPARSEBUFFER
+#define YYPARSEBUFFER	yyparsebuffer
+#endif
+#ifndef YYPARSEFILE
+#define YYPARSEFILE	yyparsefile
+#endif
+#endif
+#ifndef YY_READ_SIZE
+#define YY_READ_SIZE	4096
+#endif
+#ifndef YY_INPUT
+#define YY_INPUT(buf, result, max_size)				\
+  {								\
+    int yyc;							\
+    result= 0;							\
+    while (result < (max_size) && EOF != (yyc= getc(stdin)))	\
+      if ('\n' == ((buf)[result++]= yyc)) break;		\
+    yyprintf((stderr, "<%.*s>", result, (buf)));		\
+  }
+#endif
+#ifndef YY_BEGIN
+#define YY_BEGIN	( yybegin= yypos, 1)
+#endif
+#ifndef YY_END
+#define YY_END		( yyend= yypos, 1)
+#endif
+#ifdef YY_DEBUG
+# define yyprintf(args)	fprintf args
+#else
+# define yyprintf(args)
+#endif
+#ifndef YYSTYPE
+#define YYSTYPE	int
+#endif
+
+#ifndef YY_STACK_SIZE
+#define YY_STACK_SIZE 128
+#endif
+
+typedef struct _yycontext yycontext;
+
+#ifdef YY_CTX_LOCAL
+#define YY_CTX_PARAM_	yycontext *yyctx,
+#define YY_CTX_PARAM	yycontext *yyctx
+#define YY_CTX_ARG_	yyctx,
+#define YY_CTX_ARG	yyctx
+#else
+#define YY_CTX_PARAM_
+#define YY_CTX_PARAM	void
+#define YY_CTX_ARG_
+#define YY_CTX_ARG
+#endif
+
+#ifndef YY_PART
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#ifdef YY_BUFFER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <limits.h>
+#endif
+
+typedef void (*yyaction)(YY_CTX_PARAM_ char *yytext, int yyleng);
+typedef struct _yythunk { int begin, end;  yyaction  action;  struct _yythunk *next; } yythunk;
+
+#ifdef YY_MEMO
+typedef struct _yymemo { int rule, pos, end, begin, endtext, thunk, count; } yymemo;
+typedef struct _yymemoframe { int rule, pos, thunkpos, begin, end, gen, result; } yymemoframe;
+#endif
+
+#ifdef YY_PROFILE
+typedef struct _yyprofile { unsigned long calls, succeeded, failed, consumed, backtracked;  const char *name; } yyprofile;
+#endif
+
+#ifdef YY_CTX_LOCAL
+
+struct _yycontext
+{
+  char     *__buf;
+  int       __buflen;
+  int       __pos;
+  int       __limit;
+  char     *__text;
+  int       __textlen;
+  int       __begin;
+  int       __end;
+  int       __textmax;
+  yythunk  *__thunks;
+  int       __thunkslen;
+  int       __thunkpos;
+  YYSTYPE   __;
+  YYSTYPE  *__val;
+  YYSTYPE  *__vals;
+  int       __valslen;
+#ifdef YY_MEMO
+  yymemo   *__memos;
+  int       __memoslen;
+  int       __memoscount;
+  yythunk  *__memothunks;
+  int       __memothunkslen;
+  int       __memothunkpos;
+  int       __memogen;
+#endif
+#ifdef YY_PROFILE
+  yyprofile __profiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+  void     *__map;
+  size_t    __maplen;
+#endif
+#ifdef YY_CTX_MEMBERS
+  YY_CTX_MEMBERS
+#endif
+};
+
+#define yybuf		(yyctx->__buf)
+#define yybuflen	(yyctx->__buflen)
+#define yypos		(yyctx->__pos)
+#define yylimit		(yyctx->__limit)
+#define yytext		(yyctx->__text)
+#define yytextlen	(yyctx->__textlen)
+#define yybegin		(yyctx->__begin)
+#define yyend		(yyctx->__end)
+#define yytextmax	(yyctx->__textmax)
+#define yythunks	(yyctx->__thunks)
+#define yythunkslen	(yyctx->__thunkslen)
+#define yythunkpos	(yyctx->__thunkpos)
+#define yy		(yyctx->__)
+#define yyval		(yyctx->__val)
+#define yyvals		(yyctx->__vals)
+#define yyvalslen	(yyctx->__valslen)
+#ifdef YY_MEMO
+#define yymemos		(yyctx->__memos)
+#define yymemoslen	(yyctx->__memoslen)
+#define yymemoscount	(yyctx->__memoscount)
+#define yymemothunks	(yyctx->__memothunks)
+#define yymemothunkslen	(yyctx->__memothunkslen)
+#define yymemothunkpos	(yyctx->__memothunkpos)
+#define yymemogen	(yyctx->__memogen)
+#endif
+#ifdef YY_PROFILE
+#define yyprofiles	(yyctx->__profiles)
+#endif
+#ifdef YY_BUFFER
+#define yymap		(yyctx->__map)
+#define yymaplen	(yyctx->__maplen)
+#endif
+
+#else /* !YY_CTX_LOCAL */
+
+YY_VARIABLE(char *   ) yybuf= 0;
+YY_VARIABLE(int	     ) yybuflen= 0;
+YY_VARIABLE(int	     ) yypos= 0;
+YY_VARIABLE(int	     ) yylimit= 0;
+YY_VARIABLE(char *   ) yytext= 0;
+YY_VARIABLE(int	     ) yytextlen= 0;
+YY_VARIABLE(int	     ) yybegin= 0;
+YY_VARIABLE(int	     ) yyend= 0;
+YY_VARIABLE(int	     ) yytextmax= 0;
+YY_VARIABLE(yythunk *) yythunks= 0;
+YY_VARIABLE(int	     ) yythunkslen= 0;
+YY_VARIABLE(int      ) yythunkpos= 0;
+YY_VARIABLE(YYSTYPE  ) yy;
+YY_VARIABLE(YYSTYPE *) yyval= 0;
+YY_VARIABLE(YYSTYPE *) yyvals= 0;
+YY_VARIABLE(int      ) yyvalslen= 0;
+#ifdef YY_MEMO
+YY_VARIABLE(yymemo * ) yymemos= 0;
+YY_VARIABLE(int      ) yymemoslen= 0;
+YY_VARIABLE(int      ) yymemoscount= 0;
+YY_VARIABLE(yythunk *) yymemothunks= 0;
+YY_VARIABLE(int      ) yymemothunkslen= 0;
+YY_VARIABLE(int      ) yymemothunkpos= 0;
+YY_VARIABLE(int      ) yymemogen= 0;
+#endif
+#ifdef YY_PROFILE
+YY_VARIABLE(yyprofile) yyprofiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+YY_VARIABLE(void *   ) yymap= 0;
+YY_VARIABLE(size_t   ) yymaplen= 0;
+#endif
+
+#endif /* YY_CTX_LOCAL */
+
+#ifdef YY_BUFFER
+
+/* the whole input is already in yybuf[0 .. yylimit) */
+#define yyrefill(ctx)	0
+
+#else
+
+YY_LOCAL(int) yyrefill(YY_CTX_PARAM)
+{
+  int yyn;
+  while (yybuflen - yylimit <= YY_READ_SIZE)
+    {
+      yybuflen *= 2;
+      yybuf= realloc(yybuf, yybuflen);
+    }
+  YY_INPUT((yybuf + yylimit), yyn, YY_READ_SIZE);
+  if (!yyn) return 0;
+  yylimit += yyn;
+  return 1;
+}
+
+#endif /* YY_BUFFER */
+
+YY_LOCAL(int) yymatchDot(YY_CTX_PARAM)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  ++yypos;
+  return 1;
+}
+
+YY_LOCAL(int) yymatchChar(YY_CTX_PARAM_ int c)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  if (yybuf[yypos] == c)
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+  return 0;
+}
+
+YY_LOCAL(int) yymatchString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      if (yybuf[yypos] != *s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+/* s is in lower case and matches letters of either case */
+YY_LOCAL(int) yymatchCaselessString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos, yyc;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      yyc= (unsigned char)yybuf[yypos];
+      if (yyc >= 'A' && yyc <= 'Z') yyc |= 0x20;
+      if (yyc != (unsigned char)*s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yymatchClass(YY_CTX_PARAM_ unsigned char *bits)
+{
+  int c;
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  c= (unsigned char)yybuf[yypos];
+  if (bits[c >> 3] & (1 << (c & 7)))
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchClass @ %s\n", yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchClass @ %s\n", yybuf+yypos));
+  return 0;
+}
+
+/* c is in the class whose nibble table (see yyspanClass) is n */
+#define yyinclass(n, c)	((n)[((c) >> 7) * 16 + ((c) & 15)] & (1 << (((c) >> 4) & 7)))
+
+YY_LOCAL(int) yyspanDot(YY_CTX_PARAM)
+{
+  int yysav= yypos;
+  do yypos= yylimit;
+  while (yyrefill(YY_CTX_ARG));
+  return yypos - yysav;
+}
+
+YY_LOCAL(int) yyspanChar(YY_CTX_PARAM_ int c)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSE2__
+      __m128i yyc= _mm_set1_epi8(c);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(yyin, yyc)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	if (yybuf[yypos] != c) return yypos - yysav;
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyscanChar(YY_CTX_PARAM_ int c)
+{
+  for (;;)
+    {
+      char *yyp= memchr(yybuf + yypos, c, yylimit - yypos);
+      if (yyp)
+	{
+	  yypos= yyp - yybuf;
+	  return;
+	}
+      yypos= yylimit;
+      if (!yyrefill(YY_CTX_ARG)) return;
+    }
+}
+
+/*
+ * The class is given as a nibble table: bit (c >> 4) & 7 of byte
+ * (c >> 7) * 16 + (c & 15) is set if c is in the class.  With SSSE3 the
+ * table is indexed by the low nibbles of sixteen characters at once.
+ */
+YY_LOCAL(int) yyspanClass(YY_CTX_PARAM_ unsigned char *nibbles)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSSE3__
+      __m128i yylow= _mm_loadu_si128((__m128i *)nibbles);
+      __m128i yyhigh= _mm_loadu_si128((__m128i *)(nibbles + 16));
+      __m128i yybits= _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      __m128i yymask= _mm_set1_epi8(15);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  __m128i yylo= _mm_and_si128(yyin, yymask);
+	  __m128i yyhi= _mm_and_si128(_mm_srli_epi16(yyin, 4), yymask);
+	  __m128i yyupper= _mm_cmpgt_epi8(yyhi, _mm_set1_epi8(7));
+	  __m128i yyrow= _mm_or_si128(_mm_andnot_si128(yyupper, _mm_shuffle_epi8(yylow, yylo)),
+				      _mm_and_si128(yyupper, _mm_shuffle_epi8(yyhigh, yylo)));
+	  __m128i yybit= _mm_shuffle_epi8(yybits, yyhi);
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(yyrow, yybit), yybit)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	{
+	  int c= (unsigned char)yybuf[yypos];
+	  if (!yyinclass(nibbles, c)) return yypos - yysav;
+	}
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyDo(YY_CTX_PARAM_ yyaction action, int begin, int end)
+{
+  while (yythunkpos >= yythunkslen)
+    {
+      yythunkslen *= 2;
+      yythunks= realloc(yythunks, sizeof(yythunk) * yythunkslen);
+    }
+  yythunks[yythunkpos].begin=  begin;
+  yythunks[yythunkpos].end=    end;
+  yythunks[yythunkpos].action= action;
+  ++yythunkpos;
+}
+
+YY_LOCAL(int) yyText(YY_CTX_PARAM_ int begin, int end)
+{
+  int yyleng= end - begin;
+  if (yyleng <= 0)
+    yyleng= 0;
+  else
+    {
+      while (yytextlen < (yyleng + 1))
+	{
+	  yytextlen *= 2;
+	  yytext= realloc(yytext, yytextlen);
+	}
+      memcpy(yytext, yybuf + begin, yyleng);
+    }
+  yytext[yyleng]= '\0';
+  return yyleng;
+}
+
+YY_LOCAL(void) yyDone(YY_CTX_PARAM)
+{
+  int pos;
+  for (pos= 0;  pos < yythunkpos;  ++pos)
+    {
+      yythunk *thunk= &yythunks[pos];
+      int yyleng= thunk->end ? yyText(YY_CTX_ARG_ thunk->begin, thunk->end) : thunk->begin;
+      yyprintf((stderr, "DO [%d] %p %s\n", pos, thunk->action, yytext));
+      thunk->action(YY_CTX_ARG_ yytext, yyleng);
+    }
+  yythunkpos= 0;
+}
+
+#ifdef YY_MEMO
+
+YY_LOCAL(yymemo *) yyMemoFind(YY_CTX_PARAM_ int rule, int pos)
+{
+  unsigned mask= yymemoslen - 1;
+  unsigned h= ((unsigned)pos * YYRULECOUNT + rule) * 2654435761u & mask;
+  while (yymemos[h].rule && (yymemos[h].rule != rule || yymemos[h].pos != pos))
+    h= (h + 1) & mask;
+  return &yymemos[h];
+}
+
+YY_LOCAL(void) yyMemoGrow(YY_CTX_PARAM)
+{
+  yymemo *old= yymemos;
+  int oldlen= yymemoslen, i;
+  yymemoslen *= 2;
+  yymemos= calloc(yymemoslen, sizeof(yymemo));
+  for (i= 0;  i < oldlen;  ++i)
+    if (old[i].rule)
+      *yyMemoFind(YY_CTX_ARG_ old[i].rule, old[i].pos)= old[i];
+  free(old);
+}
+
+YY_LOCAL(void) yyMemoReset(YY_CTX_PARAM)
+{
+  if (yymemoscount)
+    memset(yymemos, 0, sizeof(yymemo) * yymemoslen);
+  yymemoscount= yymemothunkpos= 0;
+  ++yymemogen;
+}
+
+YY_LOCAL(int) yyMemoEnter(YY_CTX_PARAM_ yymemoframe *frame, int rule)
+{
+  yymemo *memo= yyMemoFind(YY_CTX_ARG_ rule, yypos);
+  frame->rule= rule;
+  frame->pos= yypos;
+  frame->thunkpos= yythunkpos;
+  frame->begin= yybegin;
+  frame->end= yyend;
+  frame->gen= yymemogen;
+  if (!memo->rule) return 0;
+  yyprintf((stderr, "  memo %d @ %d -> %d\n", rule, yypos, memo->end));
+  if ((frame->result= (memo->end >= 0)))
+    {
+      int i;
+      for (i= 0;  i < memo->count;  ++i)
+	{
+	  yythunk *thunk= &yymemothunks[memo->thunk + i];
+	  yyDo(YY_CTX_ARG_ thunk->action, thunk->begin, thunk->end);
+	}
+      if (memo->begin >= 0) yybegin= memo->begin;
+      if (memo->endtext >= 0) yyend= memo->endtext;
+      yypos= memo->end;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yyMemoLeave(YY_CTX_PARAM_ yymemoframe *frame, int ok)
+{
+  yymemo *memo;
+  if (frame->gen != yymemogen) return ok;
+  if (2 * (yymemoscount + 1) > yymemoslen) yyMemoGrow(YY_CTX_ARG);
+  memo= yyMemoFind(YY_CTX_ARG_ frame->rule, frame->pos);
+  memo->rule= frame->rule;
+  memo->pos= frame->pos;
+  memo->end= memo->begin= memo->endtext= -1;
+  memo->thunk= yymemothunkpos;
+  memo->count= 0;
+  ++yymemoscount;
+  if (ok)
+    {
+      int count= yythunkpos - frame->thunkpos;
+      while (yymemothunkpos + count > yymemothunkslen)
+	{
+	  yymemothunkslen *= 2;
+	  yymemothunks= realloc(yymemothunks, sizeof(yythunk) * yymemothunkslen);
+	}
+      memcpy(yymemothunks + yymemothunkpos, yythunks + frame->thunkpos, sizeof(yythunk) * count);
+      yymemothunkpos += count;
+      memo->count= count;
+      memo->end= yypos;
+      if (yybegin != frame->begin) memo->begin= yybegin;
+      if (yyend != frame->end) memo->endtext= yyend;
+    }
+  return ok;
+}
+
+#endif /* YY_MEMO */
+
+YY_LOCAL(void) yyCommit(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yybuf += yypos;
+  yylimit -= yypos;
+#else
+  if ((yylimit -= yypos))
+    {
+      memmove(yybuf, yybuf + yypos, yylimit);
+    }
+#endif
+#ifdef YY_MEMO
+  yyMemoReset(YY_CTX_ARG);
+#endif
+  yybegin -= yypos;
+  yyend -= yypos;
+  yypos= yythunkpos= 0;
+}
+
+YY_LOCAL(int) yyAccept(YY_CTX_PARAM_ int tp0)
+{
+  if (tp0)
+    {
+      fprintf(stderr, "accept denied at %d\n", tp0);
+      return 0;
+    }
+  else
+    {
+      yyDone(YY_CTX_ARG);
+      yyCommit(YY_CTX_ARG);
+    }
+  return 1;
+}
+
+YY_LOCAL(void) yyPush(YY_CTX_PARAM_ char *text, int count)	{ yyval += count; }
+YY_LOCAL(void) yyPop(YY_CTX_PARAM_ char *text, int count)	{ yyval -= count; }
+YY_LOCAL(void) yySet(YY_CTX_PARAM_ char *text, int count)	{ yyval[count]= yy; }
+
+#endif /* YY_PART */
+
+#define	YYACCEPT	yyAccept(YY_CTX_ARG_ yythunkpos0)
+
+YY_RULE(int) yy_factor(YY_CTX_PARAM); /* 17 */
+YY_RULE(int) yy_term(YY_CTX_PARAM); /* 15 */
+YY_RULE(int) yy_string(YY_CTX_PARAM); /* 12 */
+YY_RULE(int) yy_var(YY_CTX_PARAM); /* 10 */
+YY_RULE(int) yy_var_list(YY_CTX_PARAM); /* 9 */
+YY_RULE(int) yy_relop(YY_CTX_PARAM); /* 8 */
+YY_RULE(int) yy_expression(YY_CTX_PARAM); /* 7 */
+YY_RULE(int) yy_expr_list(YY_CTX_PARAM); /* 6 */
+YY_RULE(int) yy_number(YY_CTX_PARAM); /* 5 */
+YY_RULE(int) yy_statement(YY_CTX_PARAM); /* 3 */
+YY_RULE(int) yy_line(YY_CTX_PARAM); /* 1 */
+
+#ifdef YY_CTX_LOCAL
+#undef yytext
+#endif
+YY_ACTION(void) yy_6_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_6_relop\n"));
+   yy.binop= equalTo; ;
+}
+YY_ACTION(void) yy_5_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_5_relop\n"));
+   yy.binop= greaterThan; ;
+}
+YY_ACTION(void) yy_4_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_4_relop\n"));
+   yy.binop= greaterEqual; ;
+}
+YY_ACTION(void) yy_3_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_3_relop\n"));
+   yy.binop= lessThan; ;
+}
+YY_ACTION(void) yy_2_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_2_relop\n"));
+   yy.binop= notEqual; ;
+}
+YY_ACTION(void) yy_1_relop(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_relop\n"));
+   yy.binop= lessEqual; ;
+}
+YY_ACTION(void) yy_1_string(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_string\n"));
+   yy.string = yytext; ;
+}
+YY_ACTION(void) yy_1_number(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_number\n"));
+   yy.number = atoi(yytext); ;
+}
+YY_ACTION(void) yy_1_var(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_var\n"));
+   yy.number = yytext[0] - 'a' ;
+}
+YY_ACTION(void) yy_1_factor(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define n yyval[-1]
+#define v yyval[-2]
+  yyprintf((stderr, "do yy_1_factor\n"));
+   yy.number = variables[v.number] ;
+#undef n
+#undef v
+}
+YY_ACTION(void) yy_3_term(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_3_term\n"));
+   yy.number = l.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_term(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_2_term\n"));
+   l.number /= r.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_1_term(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_1_term\n"));
+   l.number *= r.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_4_expression(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_4_expression\n"));
+   yy.number = l.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_3_expression(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_3_expression\n"));
+   l.number -= r.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_expression(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_2_expression\n"));
+   l.number += r.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_1_expression(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_1_expression\n"));
+   l.number = -l.number ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_var_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define v yyval[-1]
+  yyprintf((stderr, "do yy_2_var_list\n"));
+   variables[v.number]= input(); ;
+#undef v
+}
+YY_ACTION(void) yy_1_var_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define v yyval[-1]
+  yyprintf((stderr, "do yy_1_var_list\n"));
+   variables[v.number]= input(); ;
+#undef v
+}
+YY_ACTION(void) yy_5_expr_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_5_expr_list\n"));
+   printf("\n"); ;
+#undef e
+}
+YY_ACTION(void) yy_4_expr_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_4_expr_list\n"));
+   printf("%d", e.number); ;
+#undef e
+}
+YY_ACTION(void) yy_3_expr_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_3_expr_list\n"));
+   printf("%s", e.string); ;
+#undef e
+}
+YY_ACTION(void) yy_2_expr_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_2_expr_list\n"));
+   printf("%d", e.number); ;
+#undef e
+}
+YY_ACTION(void) yy_1_expr_list(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_1_expr_list\n"));
+   printf("%s", e.string); ;
+#undef e
+}
+YY_ACTION(void) yy_16_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_16_statement\n"));
+   fprintf(stderr, "%s", help); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_15_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_15_statement\n"));
+   system("ls *.bas"); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_14_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_14_statement\n"));
+   type(s.string); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_13_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_13_statement\n"));
+   load(s.string); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_12_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_12_statement\n"));
+   save(s.string); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_11_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_11_statement\n"));
+   exit(0); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_10_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_10_statement\n"));
+   pc= -1;  if (batch) exit(0); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_9_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_9_statement\n"));
+   pc= 0; ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_8_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_8_statement\n"));
+   load(s.string);  pc= 0; ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_7_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_7_statement\n"));
+   int i;  for (i= 0;  i < numLines;  ++i) printf("%5d %s", lines[i].number, lines[i].text); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_6_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_6_statement\n"));
+   while (numLines) accept(lines->number, "\n"); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_5_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_5_statement\n"));
+   epc= pc;  if ((pc= sp ? stack[--sp] : -1) < 0) error("no gosub"); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_4_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_4_statement\n"));
+   epc= pc;  if (sp < 1024) stack[sp++]= pc, pc= findLine(e.number); else error("too many gosubs");
+							  if (pc < 0) error("no such line"); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_3_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_3_statement\n"));
+   variables[v.number]= e.number; ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_2_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_2_statement\n"));
+   epc= pc;  if ((pc= findLine(e.number, 0)) < 0) error("no such line"); ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_1_statement(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define v yyval[-2]
+#define e yyval[-3]
+#define e2 yyval[-4]
+#define r yyval[-5]
+#define e1 yyval[-6]
+  yyprintf((stderr, "do yy_1_statement\n"));
+   if (!r.binop(e1.number, e2.number)) yythunkpos= 0; ;
+#undef s
+#undef v
+#undef e
+#undef e2
+#undef r
+#undef e1
+}
+YY_ACTION(void) yy_3_line(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define n yyval[-1]
+#define s yyval[-2]
+  yyprintf((stderr, "do yy_3_line\n"));
+   exit(0); ;
+#undef n
+#undef s
+}
+YY_ACTION(void) yy_2_line(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define n yyval[-1]
+#define s yyval[-2]
+  yyprintf((stderr, "do yy_2_line\n"));
+   epc= pc;  error("syntax error"); ;
+#undef n
+#undef s
+}
+YY_ACTION(void) yy_1_line(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define n yyval[-1]
+#define s yyval[-2]
+  yyprintf((stderr, "do yy_1_line\n"));
+   accept(n.number, yytext); ;
+#undef n
+#undef s
+}
+#ifdef YY_CTX_LOCAL
+#define yytext		(yyctx->__text)
+#endif
+
+YY_RULE(int) yy_factor(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "factor"));
+  {  int yypos2= yypos, yythunkpos2= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l3;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g': case 'h':
+  case 'i': case 'j': case 'k': case 'l': case 'm': case 'n': case 'o': case 'p':
+  case 'q': case 'r': case 's': case 't': case 'u': case 'v': case 'w': case 'x':
+  case 'y': case 'z':  if (!yy_var(YY_CTX_ARG)) goto l3;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  yyDo(YY_CTX_ARG_ yy_1_factor, 0, 0);  goto l2;
+  case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+  case '8': case '9':  if (!yy_number(YY_CTX_ARG)) goto l3;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  goto l2;
+  case '(':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l3;
+  {  if ((unsigned char)yybuf[yypos + 0] != '(') goto l3;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expression(YY_CTX_ARG)) goto l3;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l3;
+  {  if ((unsigned char)yybuf[yypos + 0] != ')') goto l3;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  goto l2;
+  default:  goto l3;
+  }
+  l3:;	  yypos= yypos2; yythunkpos= yythunkpos2;  goto l1;
+  }
+  l2:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "factor", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l1:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "factor", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_term(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "term"));  if (!yy_factor(YY_CTX_ARG)) goto l4;  yyDo(YY_CTX_ARG_ yySet, -2, 0);
+  l5:;	
+  {  int yypos6= yypos, yythunkpos6= yythunkpos;
+  {  int yypos7= yypos, yythunkpos7= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l8;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '*':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l8;
+  {  if ((unsigned char)yybuf[yypos + 0] != '*') goto l8;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_factor(YY_CTX_ARG)) goto l8;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_term, 0, 0);  goto l7;
+  case '/':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l8;
+  {  if ((unsigned char)yybuf[yypos + 0] != '/') goto l8;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_factor(YY_CTX_ARG)) goto l8;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_term, 0, 0);  goto l7;
+  default:  goto l8;
+  }
+  l8:;	  yypos= yypos7; yythunkpos= yythunkpos7;  goto l6;
+  }
+  l7:;	  goto l5;
+  l6:;	  yypos= yypos6; yythunkpos= yythunkpos6;
+  }  yyDo(YY_CTX_ARG_ yy_3_term, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "term", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l4:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "term", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_string(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;
+  yyprintf((stderr, "%s\n", "string"));  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l9;
+  {  if ((unsigned char)yybuf[yypos + 0] != '"') goto l9;  yypos += 1;
+  }  if (!(YY_BEGIN)) goto l9;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\xff\xff\xfb\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff");  if (!(YY_END)) goto l9;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l9;
+  {  if ((unsigned char)yybuf[yypos + 0] != '"') goto l9;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_string, yybegin, yyend);
+  yyprintf((stderr, "  ok   %s @ %s\n", "string", yybuf+yypos));
+  return 1;
+  l9:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "string", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_var(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "var"));  if (!(YY_BEGIN)) goto l10;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l10;  { int yyc= (unsigned char)yybuf[yypos];  if (!((yyc >= 'a' && yyc <= 'z'))) goto l10; }  ++yypos;  if (!(YY_END)) goto l10;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_var, yybegin, yyend);
+  yyprintf((stderr, "  ok   %s @ %s\n", "var", yybuf+yypos));
+  return 1;
+  l10:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "var", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_var_list(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "var_list"));  if (!yy_var(YY_CTX_ARG)) goto l11;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_var_list, 0, 0);
+  l12:;	
+  {  int yypos13= yypos, yythunkpos13= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l13;
+  {  if ((unsigned char)yybuf[yypos + 0] != ',') goto l13;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_var(YY_CTX_ARG)) goto l13;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_var_list, 0, 0);  goto l12;
+  l13:;	  yypos= yypos13; yythunkpos= yythunkpos13;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "var_list", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l11:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "var_list", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_relop(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "relop"));
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l16;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '<':  if (yylimit - yypos >= 2)
+  {  if ((unsigned char)yybuf[yypos + 0] != '<' || (unsigned char)yybuf[yypos + 1] != '=') goto l17;  yypos += 2;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "<=")) goto l17;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_relop, 0, 0);  goto l15;
+  l17:;	  if (yylimit - yypos >= 2)
+  {  if ((unsigned char)yybuf[yypos + 0] != '<' || (unsigned char)yybuf[yypos + 1] != '>') goto l18;  yypos += 2;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "<>")) goto l18;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_2_relop, 0, 0);  goto l15;
+  l18:;	  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l16;
+  {  if ((unsigned char)yybuf[yypos + 0] != '<') goto l16;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_3_relop, 0, 0);  goto l15;
+  case '>':  if (yylimit - yypos >= 2)
+  {  if ((unsigned char)yybuf[yypos + 0] != '>' || (unsigned char)yybuf[yypos + 1] != '=') goto l19;  yypos += 2;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ ">=")) goto l19;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_4_relop, 0, 0);  goto l15;
+  l19:;	  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l16;
+  {  if ((unsigned char)yybuf[yypos + 0] != '>') goto l16;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_5_relop, 0, 0);  goto l15;
+  case '=':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l16;
+  {  if ((unsigned char)yybuf[yypos + 0] != '=') goto l16;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_6_relop, 0, 0);  goto l15;
+  default:  goto l16;
+  }
+  l16:;	  goto l14;
+  }
+  l15:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "relop", yybuf+yypos));
+  return 1;
+  l14:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "relop", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_expression(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "expression"));
+  {  int yypos21= yypos, yythunkpos21= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l22;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '(': case '+': case '0': case '1': case '2': case '3': case '4': case '5':
+  case '6': case '7': case '8': case '9': case 'a': case 'b': case 'c': case 'd':
+  case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+  case 'm': case 'n': case 'o': case 'p': case 'q': case 'r': case 's': case 't':
+  case 'u': case 'v': case 'w': case 'x': case 'y': case 'z':
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l23;
+  {  if ((unsigned char)yybuf[yypos + 0] != '+') goto l23;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  goto l24;
+  l23:;	
+  }
+  l24:;	  if (!yy_term(YY_CTX_ARG)) goto l22;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  goto l21;
+  case '-':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l22;
+  {  if ((unsigned char)yybuf[yypos + 0] != '-') goto l22;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_term(YY_CTX_ARG)) goto l22;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  yyDo(YY_CTX_ARG_ yy_1_expression, 0, 0);  goto l21;
+  default:  goto l22;
+  }
+  l22:;	  yypos= yypos21; yythunkpos= yythunkpos21;  goto l20;
+  }
+  l21:;	
+  l25:;	
+  {  int yypos26= yypos, yythunkpos26= yythunkpos;
+  {  int yypos27= yypos, yythunkpos27= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l28;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '+':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l28;
+  {  if ((unsigned char)yybuf[yypos + 0] != '+') goto l28;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_term(YY_CTX_ARG)) goto l28;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_expression, 0, 0);  goto l27;
+  case '-':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l28;
+  {  if ((unsigned char)yybuf[yypos + 0] != '-') goto l28;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_term(YY_CTX_ARG)) goto l28;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_3_expression, 0, 0);  goto l27;
+  default:  goto l28;
+  }
+  l28:;	  yypos= yypos27; yythunkpos= yythunkpos27;  goto l26;
+  }
+  l27:;	  goto l25;
+  l26:;	  yypos= yypos26; yythunkpos= yythunkpos26;
+  }  yyDo(YY_CTX_ARG_ yy_4_expression, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "expression", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l20:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "expression", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_expr_list(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "expr_list"));
+  {
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l33;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '"':  if (!yy_string(YY_CTX_ARG)) goto l33;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_expr_list, 0, 0);  goto l32;
+  case '(': case '+': case '-': case '0': case '1': case '2': case '3': case '4':
+  case '5': case '6': case '7': case '8': case '9': case 'a': case 'b': case 'c':
+  case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k':
+  case 'l': case 'm': case 'n': case 'o': case 'p': case 'q': case 'r': case 's':
+  case 't': case 'u': case 'v': case 'w': case 'x': case 'y': case 'z':  if (!yy_expression(YY_CTX_ARG)) goto l33;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_expr_list, 0, 0);  goto l32;
+  default:  goto l33;
+  }
+  l33:;	  goto l30;
+  }
+  l32:;	  goto l31;
+  l30:;	
+  }
+  l31:;	
+  l34:;	
+  {  int yypos35= yypos, yythunkpos35= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l35;
+  {  if ((unsigned char)yybuf[yypos + 0] != ',') goto l35;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l37;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '"':  if (!yy_string(YY_CTX_ARG)) goto l37;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_3_expr_list, 0, 0);  goto l36;
+  case '(': case '+': case '-': case '0': case '1': case '2': case '3': case '4':
+  case '5': case '6': case '7': case '8': case '9': case 'a': case 'b': case 'c':
+  case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k':
+  case 'l': case 'm': case 'n': case 'o': case 'p': case 'q': case 'r': case 's':
+  case 't': case 'u': case 'v': case 'w': case 'x': case 'y': case 'z':  if (!yy_expression(YY_CTX_ARG)) goto l37;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_4_expr_list, 0, 0);  goto l36;
+  default:  goto l37;
+  }
+  l37:;	  goto l35;
+  }
+  l36:;	  goto l34;
+  l35:;	  yypos= yypos35; yythunkpos= yythunkpos35;
+  }
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l39;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case ',':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l39;
+  {  if ((unsigned char)yybuf[yypos + 0] != ',') goto l39;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  goto l38;
+  default:  goto l39;
+  }
+  l39:;	
+  {  int yypos40= yypos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l40;
+  {  if ((unsigned char)yybuf[yypos + 0] != ',') goto l40;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yypos= yypos40;  goto l29;
+  l40:;	
+  }  yyDo(YY_CTX_ARG_ yy_5_expr_list, 0, 0);
+  }
+  l38:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "expr_list", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l29:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "expr_list", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_number(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "number"));  if (!(YY_BEGIN)) goto l41;  if (!yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x08\x08\x08\x08\x08\x08\x08\x08\x08\x08\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00")) goto l41;  if (!(YY_END)) goto l41;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_number, yybegin, yyend);
+  yyprintf((stderr, "  ok   %s @ %s\n", "number", yybuf+yypos));
+  return 1;
+  l41:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "number", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_statement(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 6, 0);
+  yyprintf((stderr, "%s\n", "statement"));
+  {  int yypos43= yypos, yythunkpos43= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l44;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case 'p':  if (yylimit - yypos >= 5)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'p' || (unsigned char)yybuf[yypos + 1] != 'r' || (unsigned char)yybuf[yypos + 2] != 'i' || (unsigned char)yybuf[yypos + 3] != 'n' || (unsigned char)yybuf[yypos + 4] != 't') goto l44;  yypos += 5;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "print")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expr_list(YY_CTX_ARG)) goto l44;  goto l43;
+  case 'i':  if (yylimit - yypos >= 2)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'i' || (unsigned char)yybuf[yypos + 1] != 'f') goto l45;  yypos += 2;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "if")) goto l45;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expression(YY_CTX_ARG)) goto l45;  yyDo(YY_CTX_ARG_ yySet, -6, 0);  if (!yy_relop(YY_CTX_ARG)) goto l45;  yyDo(YY_CTX_ARG_ yySet, -5, 0);  if (!yy_expression(YY_CTX_ARG)) goto l45;  yyDo(YY_CTX_ARG_ yySet, -4, 0);  yyDo(YY_CTX_ARG_ yy_1_statement, 0, 0);  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 't' || (unsigned char)yybuf[yypos + 1] != 'h' || (unsigned char)yybuf[yypos + 2] != 'e' || (unsigned char)yybuf[yypos + 3] != 'n') goto l45;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "then")) goto l45;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_statement(YY_CTX_ARG)) goto l45;  goto l43;
+  l45:;	  yypos= yypos43; yythunkpos= yythunkpos43;  if (yylimit - yypos >= 5)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'i' || (unsigned char)yybuf[yypos + 1] != 'n' || (unsigned char)yybuf[yypos + 2] != 'p' || (unsigned char)yybuf[yypos + 3] != 'u' || (unsigned char)yybuf[yypos + 4] != 't') goto l44;  yypos += 5;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "input")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_var_list(YY_CTX_ARG)) goto l44;  goto l43;
+  case 'g':  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'g' || (unsigned char)yybuf[yypos + 1] != 'o' || (unsigned char)yybuf[yypos + 2] != 't' || (unsigned char)yybuf[yypos + 3] != 'o') goto l46;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "goto")) goto l46;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expression(YY_CTX_ARG)) goto l46;  yyDo(YY_CTX_ARG_ yySet, -3, 0);  yyDo(YY_CTX_ARG_ yy_2_statement, 0, 0);  goto l43;
+  l46:;	  yypos= yypos43; yythunkpos= yythunkpos43;  if (yylimit - yypos >= 5)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'g' || (unsigned char)yybuf[yypos + 1] != 'o' || (unsigned char)yybuf[yypos + 2] != 's' || (unsigned char)yybuf[yypos + 3] != 'u' || (unsigned char)yybuf[yypos + 4] != 'b') goto l44;  yypos += 5;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "gosub")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expression(YY_CTX_ARG)) goto l44;  yyDo(YY_CTX_ARG_ yySet, -3, 0);  yyDo(YY_CTX_ARG_ yy_4_statement, 0, 0);  goto l43;
+  case 'l':  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'l' || (unsigned char)yybuf[yypos + 1] != 'e' || (unsigned char)yybuf[yypos + 2] != 't') goto l47;  yypos += 3;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "let")) goto l47;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_var(YY_CTX_ARG)) goto l47;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l47;
+  {  if ((unsigned char)yybuf[yypos + 0] != '=') goto l47;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_expression(YY_CTX_ARG)) goto l47;  yyDo(YY_CTX_ARG_ yySet, -3, 0);  yyDo(YY_CTX_ARG_ yy_3_statement, 0, 0);  goto l43;
+  l47:;	  yypos= yypos43; yythunkpos= yythunkpos43;  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'l' || (unsigned char)yybuf[yypos + 1] != 'i' || (unsigned char)yybuf[yypos + 2] != 's' || (unsigned char)yybuf[yypos + 3] != 't') goto l48;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "list")) goto l48;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_7_statement, 0, 0);  goto l43;
+  l48:;	  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'l' || (unsigned char)yybuf[yypos + 1] != 'o' || (unsigned char)yybuf[yypos + 2] != 'a' || (unsigned char)yybuf[yypos + 3] != 'd') goto l44;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "load")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_string(YY_CTX_ARG)) goto l44;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_13_statement, 0, 0);  goto l43;
+  case 'r':  if (yylimit - yypos >= 6)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'r' || (unsigned char)yybuf[yypos + 1] != 'e' || (unsigned char)yybuf[yypos + 2] != 't' || (unsigned char)yybuf[yypos + 3] != 'u' || (unsigned char)yybuf[yypos + 4] != 'r' || (unsigned char)yybuf[yypos + 5] != 'n') goto l49;  yypos += 6;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "return")) goto l49;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_5_statement, 0, 0);  goto l43;
+  l49:;	  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'r' || (unsigned char)yybuf[yypos + 1] != 'u' || (unsigned char)yybuf[yypos + 2] != 'n') goto l50;  yypos += 3;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "run")) goto l50;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");
+  {  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l52;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '"':  if (!yy_string(YY_CTX_ARG)) goto l52;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_8_statement, 0, 0);  goto l51;
+  default:  goto l52;
+  }
+  l52:;	  yyDo(YY_CTX_ARG_ yy_9_statement, 0, 0);
+  }
+  l51:;	  goto l43;
+  l50:;	  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'r' || (unsigned char)yybuf[yypos + 1] != 'e' || (unsigned char)yybuf[yypos + 2] != 'm') goto l44;  yypos += 3;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "rem")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe\xff\xff\xfe\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff");  goto l43;
+  case 'c':  if (yylimit - yypos >= 5)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'c' || (unsigned char)yybuf[yypos + 1] != 'l' || (unsigned char)yybuf[yypos + 2] != 'e' || (unsigned char)yybuf[yypos + 3] != 'a' || (unsigned char)yybuf[yypos + 4] != 'r') goto l44;  yypos += 5;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "clear")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_6_statement, 0, 0);  goto l43;
+  case 'b': case 'e': case 'q':  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'e' || (unsigned char)yybuf[yypos + 1] != 'n' || (unsigned char)yybuf[yypos + 2] != 'd') goto l53;  yypos += 3;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "end")) goto l53;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_10_statement, 0, 0);  goto l43;
+  l53:;	
+  {  int yyrmarker= yypos, yyraccept= 0;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l54;
+  switch ((unsigned char)yybuf[yypos++])
+  {
+  case 'b':  if (yylimit - yypos >= 2)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'y' || (unsigned char)yybuf[yypos + 1] != 'e') goto l54;  yypos += 2;
+  }
+  else if (!yymatchString(YY_CTX_ARG_ "ye")) goto l54;
+  goto l55;
+  case 'e':  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'x' || (unsigned char)yybuf[yypos + 1] != 'i' || (unsigned char)yybuf[yypos + 2] != 't') goto l54;  yypos += 3;
+  }
+  else if (!yymatchString(YY_CTX_ARG_ "xit")) goto l54;
+  goto l55;
+  case 'q':  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'u' || (unsigned char)yybuf[yypos + 1] != 'i' || (unsigned char)yybuf[yypos + 2] != 't') goto l54;  yypos += 3;
+  }
+  else if (!yymatchString(YY_CTX_ARG_ "uit")) goto l54;
+  goto l55;
+  default:  goto l54;
+  }
+  l54:;	  yypos= yyrmarker;  if (!yyraccept)  goto l44;
+  l55:;	
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_11_statement, 0, 0);  goto l43;
+  case 's':  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 's' || (unsigned char)yybuf[yypos + 1] != 'a' || (unsigned char)yybuf[yypos + 2] != 'v' || (unsigned char)yybuf[yypos + 3] != 'e') goto l44;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "save")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_string(YY_CTX_ARG)) goto l44;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_12_statement, 0, 0);  goto l43;
+  case 't':  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 't' || (unsigned char)yybuf[yypos + 1] != 'y' || (unsigned char)yybuf[yypos + 2] != 'p' || (unsigned char)yybuf[yypos + 3] != 'e') goto l44;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "type")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_string(YY_CTX_ARG)) goto l44;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_14_statement, 0, 0);  goto l43;
+  case 'd':  if (yylimit - yypos >= 3)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'd' || (unsigned char)yybuf[yypos + 1] != 'i' || (unsigned char)yybuf[yypos + 2] != 'r') goto l44;  yypos += 3;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "dir")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_15_statement, 0, 0);  goto l43;
+  case 'h':  if (yylimit - yypos >= 4)
+  {  if ((unsigned char)yybuf[yypos + 0] != 'h' || (unsigned char)yybuf[yypos + 1] != 'e' || (unsigned char)yybuf[yypos + 2] != 'l' || (unsigned char)yybuf[yypos + 3] != 'p') goto l44;  yypos += 4;
+  }
+  else
+  {  if (!yymatchString(YY_CTX_ARG_ "help")) goto l44;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_16_statement, 0, 0);  goto l43;
+  default:  goto l44;
+  }
+  l44:;	  yypos= yypos43; yythunkpos= yythunkpos43;  goto l42;
+  }
+  l43:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "statement", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 6, 0);
+  return 1;
+  l42:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "statement", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_line(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "line"));
+  {  int yypos57= yypos, yythunkpos57= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l58;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case 0x09: case ' ': case 'b': case 'c': case 'd': case 'e': case 'g': case 'h':
+  case 'i': case 'l': case 'p': case 'q': case 'r': case 's': case 't':  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_statement(YY_CTX_ARG)) goto l58;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l58;  { int yyc= (unsigned char)yybuf[yypos];  if (!(yyc == 0x0a || yyc == 0x0d)) goto l58; }  ++yypos;  goto l57;
+  default:  goto l58;
+  }
+  l58:;	  yypos= yypos57; yythunkpos= yythunkpos57;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");
+  {  int yypos59= yypos, yythunkpos59= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l60;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case 0x00: case 0x01: case 0x02: case 0x03: case 0x04: case 0x05: case 0x06: case 0x07:
+  case 0x08: case 0x09: case 0x0a: case 0x0b: case 0x0c: case 0x0d: case 0x0e: case 0x0f:
+  case 0x10: case 0x11: case 0x12: case 0x13: case 0x14: case 0x15: case 0x16: case 0x17:
+  case 0x18: case 0x19: case 0x1a: case 0x1b: case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+  case ' ': case '!': case '"': case '#': case '$': case '%': case '&': case 0x27:
+  case '(': case ')': case '*': case '+': case ',': case '-': case '.': case '/':
+  case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+  case '8': case '9': case ':': case ';': case '<': case '=': case '>': case '?':
+  case '@': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F': case 'G':
+  case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N': case 'O':
+  case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W':
+  case 'X': case 'Y': case 'Z': case '[': case 0x5c: case ']': case '^': case '_':
+  case '`': case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g':
+  case 'h': case 'i': case 'j': case 'k': case 'l': case 'm': case 'n': case 'o':
+  case 'p': case 'q': case 'r': case 's': case 't': case 'u': case 'v': case 'w':
+  case 'x': case 'y': case 'z': case '{': case '|': case '}': case '~': case 0x7f:
+  case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+  case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+  case 0x90: case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+  case 0x98: case 0x99: case 0x9a: case 0x9b: case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+  case 0xa0: case 0xa1: case 0xa2: case 0xa3: case 0xa4: case 0xa5: case 0xa6: case 0xa7:
+  case 0xa8: case 0xa9: case 0xaa: case 0xab: case 0xac: case 0xad: case 0xae: case 0xaf:
+  case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+  case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+  case 0xc0: case 0xc1: case 0xc2: case 0xc3: case 0xc4: case 0xc5: case 0xc6: case 0xc7:
+  case 0xc8: case 0xc9: case 0xca: case 0xcb: case 0xcc: case 0xcd: case 0xce: case 0xcf:
+  case 0xd0: case 0xd1: case 0xd2: case 0xd3: case 0xd4: case 0xd5: case 0xd6: case 0xd7:
+  case 0xd8: case 0xd9: case 0xda: case 0xdb: case 0xdc: case 0xdd: case 0xde: case 0xdf:
+  case 0xe0: case 0xe1: case 0xe2: case 0xe3: case 0xe4: case 0xe5: case 0xe6: case 0xe7:
+  case 0xe8: case 0xe9: case 0xea: case 0xeb: case 0xec: case 0xed: case 0xee: case 0xef:
+  case 0xf0: case 0xf1: case 0xf2: case 0xf3: case 0xf4: case 0xf5: case 0xf6: case 0xf7:
+  case 0xf8: case 0xf9: case 0xfa: case 0xfb: case 0xfc: case 0xfd: case 0xfe: case 0xff:
+  if (!yy_number(YY_CTX_ARG)) goto l61;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  if (!(YY_BEGIN)) goto l61;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe\xff\xff\xfe\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff");  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l61;  { int yyc= (unsigned char)yybuf[yypos];  if (!(yyc == 0x0a || yyc == 0x0d)) goto l61; }  ++yypos;  if (!(YY_END)) goto l61;  yyDo(YY_CTX_ARG_ yy_1_line, yybegin, yyend);  goto l59;
+  l61:;	  yypos= yypos59; yythunkpos= yythunkpos59;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l62;  { int yyc= (unsigned char)yybuf[yypos];  if (!(yyc == 0x0a || yyc == 0x0d)) goto l62; }  ++yypos;  goto l59;
+  l62:;	  if (!(YY_BEGIN)) goto l60;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe\xff\xff\xfe\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff");  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l60;  { int yyc= (unsigned char)yybuf[yypos];  if (!(yyc == 0x0a || yyc == 0x0d)) goto l60; }  ++yypos;  if (!(YY_END)) goto l60;  yyDo(YY_CTX_ARG_ yy_2_line, 0, 0);  goto l59;
+  default:  goto l60;
+  }
+  l60:;	  yypos= yypos59; yythunkpos= yythunkpos59;
+  {  int yypos63= yypos;  if (!yymatchDot(YY_CTX_ARG)) goto l63;  yypos= yypos63;  goto l56;
+  l63:;	
+  }  yyDo(YY_CTX_ARG_ yy_3_line, 0, 0);
+  }
+  l59:;	
+  }
+  l57:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "line", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l56:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "line", yybuf+yypos));
+  return 0;
+}
+
+#ifndef YY_PART
+
+typedef int (*yyrule)(YY_CTX_PARAM);
+
+YY_PARSE(int) YYPARSEFROM(YY_CTX_PARAM_ yyrule yystart)
+{
+  int yyok;
+  if (!yybuflen)
+    {
+      yybuflen= 1024;
+#ifndef YY_BUFFER
+      yybuf= malloc(yybuflen);
+#endif
+      yytextlen= 1024;
+      yytext= malloc(yytextlen);
+      yythunkslen= YY_STACK_SIZE;
+      yythunks= malloc(sizeof(yythunk) * yythunkslen);
+      yyvalslen= YY_STACK_SIZE;
+      yyvals= malloc(sizeof(YYSTYPE) * yyvalslen);
+#ifdef YY_MEMO
+      yymemoslen= 1024;
+      yymemos= calloc(yymemoslen, sizeof(yymemo));
+      yymemothunkslen= YY_STACK_SIZE;
+      yymemothunks= malloc(sizeof(yythunk) * yymemothunkslen);
+#endif
+#ifdef YY_BUFFER
+      yybegin= yyend= yythunkpos= 0;	/* yybuf, yypos and yylimit were set by YYPARSEBUFFER */
+#else
+      yybegin= yyend= yypos= yylimit= yythunkpos= 0;
+#endif
+    }
+  yybegin= yyend= yypos;
+  yythunkpos= 0;
+  yyval= yyvals;
+  yyok= yystart(YY_CTX_ARG);
+  if (yyok) yyDone(YY_CTX_ARG);
+  yyCommit(YY_CTX_ARG);
+  return yyok;
+#ifndef YY_BUFFER
+  (void)yyrefill;
+#endif
+  (void)yymatchDot;
+  (void)yymatchChar;
+  (void)yymatchString;
+  (void)yymatchCaselessString;
+  (void)yymatchClass;
+  (void)yyspanDot;
+  (void)yyspanChar;
+  (void)yyspanClass;
+  (void)yyscanChar;
+  (void)yyDo;
+  (void)yyText;
+  (void)yyDone;
+  (void)yyCommit;
+  (void)yyAccept;
+  (void)yyPush;
+  (void)yyPop;
+  (void)yySet;
+  (void)yytextmax;
+}
+
+YY_PARSE(int) YYPARSE(YY_CTX_PARAM)
+{
+  return YYPARSEFROM(YY_CTX_ARG_ yy_line);
+}
+
+#ifdef YY_BUFFER
+
+YY_LOCAL(void) yyunmap(YY_CTX_PARAM)
+{
+  if (yymap)
+    {
+      munmap(yymap, yymaplen);
+      yymap= 0;
+      yymaplen= 0;
+    }
+}
+
+YY_PARSE(int) YYPARSEBUFFER(YY_CTX_PARAM_ const char *data, size_t len)
+{
+  if (len > INT_MAX)
+    {
+      errno= EOVERFLOW;
+      return -1;
+    }
+  yybuf= (char *)data;
+  yylimit= len;
+  yybegin= yyend= yypos= 0;
+  return YYPARSE(YY_CTX_ARG);
+}
+
+YY_PARSE(int) YYPARSEFILE(YY_CTX_PARAM_ const char *path)
+{
+  struct stat st;
+  void *map= 0;
+  int fd;
+  if ((fd= open(path, O_RDONLY)) < 0)
+    return -1;
+  if (fstat(fd, &st) < 0
+      || (st.st_size > INT_MAX && (errno= EOVERFLOW))
+      || (st.st_size && MAP_FAILED == (map= mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))))
+    {
+      close(fd);
+      return -1;
+    }
+  close(fd);
+  yyunmap(YY_CTX_ARG);
+  yymap= map;
+  yymaplen= st.st_size;
+  return YYPARSEBUFFER(YY_CTX_ARG_ map ? (char *)map : "", st.st_size);
+}
+
+#endif /* YY_BUFFER */
+
+#ifdef YY_PROFILE
+
+YY_LOCAL(int) yyprofilecmp(const void *a, const void *b)
+{
+  const yyprofile *p= a, *q= b;
+  if (p->calls != q->calls) return p->calls < q->calls ? 1 : -1;
+  return strcmp(p->name, q->name);
+}
+
+YY_PARSE(void) YYPROFILEDUMP(YY_CTX_PARAM_ FILE *stream)
+{
+  yyprofile yyreport[YYRULECOUNT];
+  int i;
+  for (i= 0;  i < YYRULECOUNT;  ++i)
+    {
+      yyreport[i]= yyprofiles[i + 1];
+      yyreport[i].name= yyrulenames[i + 1];
+    }
+  qsort(yyreport, YYRULECOUNT, sizeof(yyprofile), yyprofilecmp);
+  fprintf(stream, "%12s %12s %12s %14s %14s  %s\n",
+	  "calls", "succeeded", "failed", "consumed", "backtracked", "rule");
+  for (i= 0;  i < YYRULECOUNT && yyreport[i].calls;  ++i)
+    fprintf(stream, "%12lu %12lu %12lu %14lu %14lu  %s\n",
+	    yyreport[i].calls, yyreport[i].succeeded, yyreport[i].failed,
+	    yyreport[i].consumed, yyreport[i].backtracked, yyreport[i].name);
+}
+
+#endif /* YY_PROFILE */
+
+YY_PARSE(void) YYRELEASE(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yyunmap(YY_CTX_ARG);
+#endif
+  if (yybuflen)
+    {
+#ifndef YY_BUFFER
+      free(yybuf);
+#endif
+      free(yytext);
+      free(yythunks);
+      free(yyvals);
+#ifdef YY_MEMO
+      free(yymemos);
+      free(yymemothunks);
+#endif
+      yybuflen= 0;
+    }
+}
+
+#endif
+
+
+#include <unistd.h>
+#include <stdarg.h>
+
+char *help=
+  "print <num>|<string> [, <num>|<string> ...] [,]\n"
+  "if <expr> <|<=|<>|=|>=|> <expr> then <stmt>\n"
+  "input <var> [, <var> ...]     let <var> = <expr>\n"
+  "goto <expr>                   gosub <expr>\n"
+  "end                           return\n"
+  "list                          clear\n"
+  "run [\"filename\"]              rem <comment...>\n"
+  "dir                           type \"filename\"\n"
+  "save \"filename\"               load \"filename\"\n"
+  "bye|quit|exit                 help\n"
+  ;
+
+void error(char *fmt, ...)
+{
+  va_list ap;
+  va_start(ap, fmt);
+  if (epc > 0)
+    fprintf(stderr, "\nline %d: %s", lines[epc-1].number, lines[epc-1].text);
+  else
+    fprintf(stderr, "\n");
+  vfprintf(stderr, fmt, ap);
+  fprintf(stderr, "\n");
+  va_end(ap);
+  epc= pc= -1;
+}
+
+#ifdef USE_READLINE
+# include <readline/readline.h>
+# include <readline/history.h>
+#endif
+
+int nextLine(char *buf, int max)
+{
+  pc= -1;
+  if (batch) exit(0);
+  if (isatty(fileno(stdin)))
+    {
+#    ifdef USE_READLINE
+      char *line= readline(">");
+      if (line)
+	{
+	  int len= strlen(line);
+	  if (len >= max) len= max - 1;
+	  strncpy(buf, line, len);
+	  (buf)[len]= '\n';
+	  add_history(line);
+	  free(line);
+	  return len + 1;
+	}
+      else
+	{
+	  printf("\n");
+	  return 0;
+	}
+#    endif
+      putchar('>');
+      fflush(stdout);
+    }
+  return fgets(buf, max, stdin) ? strlen(buf) : 0;
+}
+
+int maxLines= 0;
+
+int findLine(int n, int create)
+{
+  int lo= 0, hi= numLines - 1;
+  while (lo <= hi)
+    {
+      int mid= (lo + hi) / 2, lno= lines[mid].number;
+      if (lno > n)
+	hi= mid - 1;
+      else if (lno < n)
+	lo= mid + 1;
+      else
+	return mid;
+    }
+  if (create)
+    {
+      if (numLines == maxLines)
+	{
+	  maxLines *= 2;
+	  lines= realloc(lines, sizeof(line) * maxLines);
+	}
+      if (lo < numLines)
+	memmove(lines + lo + 1, lines + lo, sizeof(line) * (numLines - lo));
+      ++numLines;
+      lines[lo].number= n;
+      lines[lo].text= 0;
+      return lo;
+    }
+  return -1;
+}
+
+void accept(int n, char *s)
+{
+  if (s[0] < 32)	/* delete */
+    {
+      int lno= findLine(n, 0);
+      if (lno >= 0)
+	{
+	  if (lno < numLines - 1)
+	    memmove(lines + lno, lines + lno + 1, sizeof(line) * (numLines - lno - 1));
+	  --numLines;
+	}
+    }
+  else			/* insert */
+    {
+      int lno= findLine(n, 1);
+      if (lines[lno].text) free(lines[lno].text);
+      lines[lno].length= strlen(s);
+      lines[lno].text= strdup(s);
+    }
+}
+
+char *extend(char *name)
+{
+  static char path[1024];
+  int len= strlen(name);
+  sprintf(path, "%s%s", name, (((len > 4) && !strcasecmp(".bas", name + len - 4)) ? "" : ".bas"));
+  return path;
+}
+
+void save(char *name)
+{
+  FILE *f= fopen(name= extend(name), "w");
+  if (!f)
+    perror(name);
+  else
+    {
+      int i;
+      for (i= 0;  i < numLines;  ++i)
+	fprintf(f, "%d %s", lines[i].number, lines[i].text);
+      fclose(f);
+    }
+}
+
+void load(char *name)
+{
+  FILE *f= fopen(name= extend(name), "r");
+  if (!f)
+    perror(name);
+  else
+    {
+      int  lineNumber;
+      char lineText[1024];
+      while ((1 == fscanf(f, " %d ", &lineNumber)) && fgets(lineText, sizeof(lineText), f))
+	accept(lineNumber, lineText);
+      fclose(f);
+    }
+}
+
+void type(char *name)
+{
+  FILE *f= fopen(name= extend(name), "r");
+  if (!f)
+    perror(name);
+  else
+    {
+      int  c, d;
+      while ((c= getc(f)) >= 0)
+	putchar(d= c);
+      fclose(f);
+      if ('\n' != d && '\r' != d) putchar('\n');
+    }
+}
+
+int input(void)
+{
+  char line[32];
+  fgets(line, sizeof(line), stdin);
+  return atoi(line);
+}
+
+int main(int argc, char **argv)
+{
+  lines= malloc(sizeof(line) * (maxLines= 32));
+  numLines= 0;
+
+  if (argc > 1)
+    {
+      batch= 1;
+      while (argc-- > 1)
+	load(*++argv);
+      pc= 0;
+    }
+
+  while (!feof(stdin))
+    yyparse();
+
+  return 0;
+}
+
@@ -0,0 +1,182 @@
+/* Generate large, deterministic inputs for the example grammars.
+ *
+ *   benchgen example megabytes > input
+ *
+ * The output is valid input for the named example (wc, calc, dc, dcv
+ * or basic) and is at least the requested number of megabytes long.
+ * Divisors are always nonzero literals so that no example traps.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+static unsigned long seed= 12345;
+
+static int rnd(int n)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return (int)((seed >> 11) % n);
+}
+
+static char  line[1024];
+static int   linelen= 0;
+
+static void put(const char *fmt, ...)
+{
+  va_list ap;
+  va_start(ap, fmt);
+  linelen += vsnprintf(line + linelen, sizeof(line) - linelen, fmt, ap);
+  va_end(ap);
+}
+
+static void space(void)
+{
+  static const char *spaces[]= { "", "", " ", " ", "  ", "\t" };
+  put("%s", spaces[rnd(6)]);
+}
+
+static void operand(int vars)
+{
+  if (vars && rnd(3) == 0)
+    put("%c", 'a' + rnd(26));
+  else
+    put("%d", rnd(100));
+}
+
+/* product of two operands, or division of an operand by a nonzero digit */
+
+static void product(int vars)
+{
+  operand(vars);
+  switch (rnd(3))
+    {
+    case 0:	space();  put("*");  space();  operand(vars);	break;
+    case 1:	space();  put("/");  space();  put("%d", 1 + rnd(9));	break;
+    }
+}
+
+/* sum of at most three products, one of which may scale a parenthesised sum */
+
+static void expression(int vars, int nest)
+{
+  int i, n= 1 + rnd(3);
+  for (i= 0;  i < n;  ++i)
+    {
+      if (i)
+	{
+	  space();  put("%c", rnd(2) ? '+' : '-');  space();
+	}
+      if (nest && rnd(4) == 0)
+	{
+	  put("%d", rnd(100));  space();  put("*");  space();
+	  put("(");  space();  expression(vars, 0);  space();  put(")");
+	}
+      else
+	product(vars);
+    }
+}
+
+static const char *words[]= {
+  "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "parsing",
+  "expression", "grammar", "Packrat", "memo", "BACKTRACK", "a", "of",
+};
+
+static void wc(void)
+{
+  int i, n= 4 + rnd(12);
+  for (i= 0;  i < n;  ++i)
+    {
+      if (i) put("%s", rnd(8) ? " " : ", ");
+      put("%s", words[rnd(sizeof(words) / sizeof(*words))]);
+      if (rnd(10) == 0) put("%d", rnd(1000));
+    }
+  put(rnd(4) ? ".\n" : "\n\r");
+}
+
+static void calc(void)
+{
+  space();
+  if (rnd(2))
+    {
+      put("%c", 'a' + rnd(26));  space();  put("=");  space();
+    }
+  expression(1, 1);
+  space();
+  put(rnd(4) ? "\n" : ";");
+}
+
+static void dc(void)
+{
+  space();  expression(0, 1);  space();  put("\n");
+}
+
+static void dcv(void)
+{
+  calc();
+}
+
+static void basic(void)
+{
+  switch (rnd(8))
+    {
+    case 0:
+      put("print ");  expression(1, 1);  put(", \" \", ");  expression(1, 1);
+      break;
+    case 1:
+      put("if ");  expression(1, 0);  put(" < ");  expression(1, 0);
+      put(" then let %c = ", 'a' + rnd(26));  expression(1, 1);
+      break;
+    case 2:
+      put("rem the quick brown fox jumps over the lazy dog");
+      break;
+    default:
+      put("let %c = ", 'a' + rnd(26));  expression(1, 1);
+      break;
+    }
+  put("\n");
+}
+
+static struct {
+  const char  *name;
+  void	     (*generate)(void);
+} examples[]= {
+  { "wc",	wc },
+  { "calc",	calc },
+  { "dc",	dc },
+  { "dcv",	dcv },
+  { "basic",	basic },
+  { 0, 0 }
+};
+
+int main(int argc, char **argv)
+{
+  long long size, total= 0;
+  int i;
+
+  if (argc != 3)
+    {
+      fprintf(stderr, "usage: %s example megabytes\n", argv[0]);
+      return 1;
+    }
+  for (i= 0;  examples[i].name && strcmp(examples[i].name, argv[1]);  ++i)
+    ;
+  if (!examples[i].name)
+    {
+      fprintf(stderr, "%s: no generator for '%s'\n", argv[0], argv[1]);
+      return 1;
+    }
+  size= atoll(argv[2]) * 1024 * 1024;
+  while (total < size)
+    {
+      linelen= 0;
+      examples[i].generate();
+      fwrite(line, 1, linelen, stdout);
+      total += linelen;
+    }
+
+  return ferror(stdout) || fclose(stdout);
+}
@@ -0,0 +1,101 @@
+/* Time an example parser over an input file.
+ *
+ *   benchrun [-n runs] name input command [argument ...]
+ *
+ * Runs the command with standard input read from the input file and
+ * standard output discarded, and prints one tab-separated line:
+ *
+ *   name  bytes  seconds  MB/s  ns/byte  maxrss(kB)
+ *
+ * With -n the command is run that many times and the fastest run is
+ * reported.  The peak resident set size comes from wait4() and is the
+ * largest seen over all runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int run(char *input, char **command, double *seconds, long *maxrss)
+{
+  struct rusage usage;
+  double start= now();
+  int status;
+  pid_t pid;
+
+  switch (pid= fork())
+    {
+    case -1:
+      perror("fork");
+      return -1;
+    case 0:
+      if (!freopen(input, "r", stdin) || !freopen("/dev/null", "w", stdout))
+	{
+	  perror(input);
+	  _exit(127);
+	}
+      execvp(command[0], command);
+      perror(command[0]);
+      _exit(127);
+    }
+  if (wait4(pid, &status, 0, &usage) < 0)
+    {
+      perror("wait4");
+      return -1;
+    }
+  *seconds= now() - start;
+  if (usage.ru_maxrss > *maxrss) *maxrss= usage.ru_maxrss;
+  if (!WIFEXITED(status) || WEXITSTATUS(status))
+    {
+      fprintf(stderr, "%s: failed with status 0x%x\n", command[0], status);
+      return -1;
+    }
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  double best= 0.0, seconds;
+  long maxrss= 0;
+  int runs= 1, i;
+  struct stat st;
+
+  if (argc > 2 && !strcmp(argv[1], "-n"))
+    {
+      runs= atoi(argv[2]);
+      argc -= 2, argv += 2;
+    }
+  if (argc < 4 || runs < 1)
+    {
+      fprintf(stderr, "usage: benchrun [-n runs] name input command [argument ...]\n");
+      return 1;
+    }
+  if (stat(argv[2], &st))
+    {
+      perror(argv[2]);
+      return 1;
+    }
+  for (i= 0;  i < runs;  ++i)
+    {
+      if (run(argv[2], argv + 3, &seconds, &maxrss)) return 1;
+      if (!i || seconds < best) best= seconds;
+    }
+  printf("%s\t%lld\t%.3f\t%.1f\t%.2f\t%ld\n", argv[1], (long long)st.st_size, best,
+	 st.st_size / best / (1024 * 1024), best * 1e9 / st.st_size, maxrss);
+
+  return 0;
+}
@@ -0,0 +1,1075 @@
+/* A recursive-descent parser generated by peg 0.1.2 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define YYRULECOUNT 16
+
+#include <stdio.h>
+int vars[26];
+
+#ifndef YY_VARIABLE
+#define YY_VARIABLE(T)	static T
+#endif
+#ifndef YY_LOCAL
+#define YY_LOCAL(T)	static T
+#endif
+#ifndef YY_ACTION
+#define YY_ACTION(T)	static T
+#endif
+#ifndef YY_RULE
+#define YY_RULE(T)	static T
+#endif
+#ifndef YY_PARSE
+#define YY_PARSE(T)	T
+#endif
+#ifndef YYPARSE
+#define YYPARSE		yyparse
+#endif
+#ifndef YYPARSEFROM
+#define YYPARSEFROM	yyparsefrom
+#endif
+#ifndef YYRELEASE
+#define YYRELEASE	yyrelease
+#endif
+#ifdef YY_PROFILE
+#ifndef YYPROFILEDUMP
+#define YYPROFILEDUMP	yyprofile_dump
+#endif
+#endif
+#ifdef YY_BUFFER
+#ifndef YYPARSEBUFFER
+#define YYPARSEBUFFER	yyparsebuffer
+#endif
+#ifndef YYPARSEFILE
+#define YYPARSEFILE	yyparsefile
+#endif
+#endif
+#ifndef YY_READ_SIZE
+#define YY_READ_SIZE	4096
+#endif
+#ifndef YY_INPUT
+#define YY_INPUT(buf, result, max_size)				\
+  {								\
+    int yyc;							\
+    result= 0;							\
+    while (result < (max_size) && EOF != (yyc= getc(stdin)))	\
+      if ('\n' == ((buf)[result++]= yyc)) break;		\
+    yyprintf((stderr, "<%.*s>", result, (buf)));		\
+  }
+#endif
+#ifndef YY_BEGIN
+#define YY_BEGIN	( yybegin= yypos, 1)
+#endif
+#ifndef YY_END
+#define YY_END		( yyend= yypos, 1)
+#endif
+#ifdef YY_DEBUG
+# define yyprintf(args)	fprintf args
+#else
+# define yyprintf(args)
+#endif
+#ifndef YYSTYPE
+#define YYSTYPE	int
+#endif
+
+#ifndef YY_STACK_SIZE
+#define YY_STACK_SIZE 128
+#endif
+
+typedef struct _yycontext yycontext;
+
+#ifdef YY_CTX_LOCAL
+#define YY_CTX_PARAM_	yycontext *yyctx,
+#define YY_CTX_PARAM	yycontext *yyctx
+#define YY_CTX_ARG_	yyctx,
+#define YY_CTX_ARG	yyctx
+#else
+#define YY_CTX_PARAM_
+#define YY_CTX_PARAM	void
+#define YY_CTX_ARG_
+#define YY_CTX_ARG
+#endif
+
+#ifndef YY_PART
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#ifdef YY_BUFFER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <limits.h>
+#endif
+
+typedef void (*yyaction)(YY_CTX_PARAM_ char *yytext, int yyleng);
+typedef struct _yythunk { int begin, end;  yyaction  action;  struct _yythunk *next; } yythunk;
+
+#ifdef YY_MEMO
+typedef struct _yymemo { int rule, pos, end, begin, endtext, thunk, count; } yymemo;
+typedef struct _yymemoframe { int rule, pos, thunkpos, begin, end, gen, result; } yymemoframe;
+#endif
+
+#ifdef YY_PROFILE
+typedef struct _yyprofile { unsigned long calls, succeeded, failed, consumed, backtracked;  const char *name; } yyprofile;
+#endif
+
+#ifdef YY_CTX_LOCAL
+
+struct _yycontext
+{
+  char     *__buf;
+  int       __buflen;
+  int       __pos;
+  int       __limit;
+  char     *__text;
+  int       __textlen;
+  int       __begin;
+  int       __end;
+  int       __textmax;
+  yythunk  *__thunks;
+  int       __thunkslen;
+  int       __thunkpos;
+  YYSTYPE   __;
+  YYSTYPE  *__val;
+  YYSTYPE  *__vals;
+  int       __valslen;
+#ifdef YY_MEMO
+  yymemo   *__memos;
+  int       __memoslen;
+  int       __memoscount;
+  yythunk  *__memothunks;
+  int       __memothunkslen;
+  int       __memothunkpos;
+  int       __memogen;
+#endif
+#ifdef YY_PROFILE
+  yyprofile __profiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+  void     *__map;
+  size_t    __maplen;
+#endif
+#ifdef YY_CTX_MEMBERS
+  YY_CTX_MEMBERS
+#endif
+};
+
+#define yybuf		(yyctx->__buf)
+#define yybuflen	(yyctx->__buflen)
+#define yypos		(yyctx->__pos)
+#define yylimit		(yyctx->__limit)
+#define yytext		(yyctx->__text)
+#define yytextlen	(yyctx->__textlen)
+#define yybegin		(yyctx->__begin)
+#define yyend		(yyctx->__end)
+#define yytextmax	(yyctx->__textmax)
+#define yythunks	(yyctx->__thunks)
+#define yythunkslen	(yyctx->__thunkslen)
+#define yythunkpos	(yyctx->__thunkpos)
+#define yy		(yyctx->__)
+#define yyval		(yyctx->__val)
+#define yyvals		(yyctx->__vals)
+#define yyvalslen	(yyctx->__valslen)
+#ifdef YY_MEMO
+#define yymemos		(yyctx->__memos)
+#define yymemoslen	(yyctx->__memoslen)
+#define yymemoscount	(yyctx->__memoscount)
+#define yymemothunks	(yyctx->__memothunks)
+#define yymemothunkslen	(yyctx->__memothunkslen)
+#define yymemothunkpos	(yyctx->__memothunkpos)
+#define yymemogen	(yyctx->__memogen)
+#endif
+#ifdef YY_PROFILE
+#define yyprofiles	(yyctx->__profiles)
+#endif
+#ifdef YY_BUFFER
+#define yymap		(yyctx->__map)
+#define yymaplen	(yyctx->__maplen)
+#endif
+
+#else /* !YY_CTX_LOCAL */
+
+YY_VARIABLE(char *   ) yybuf= 0;
+YY_VARIABLE(int	     ) yybuflen= 0;
+YY_VARIABLE(int	     ) yypos= 0;
+YY_VARIABLE(int	     ) yylimit= 0;
+YY_VARIABLE(char *   ) yytext= 0;
+YY_VARIABLE(int	     ) yytextlen= 0;
+YY_VARIABLE(int	     ) yybegin= 0;
+YY_VARIABLE(int	     ) yyend= 0;
+YY_VARIABLE(int	     ) yytextmax= 0;
+YY_VARIABLE(yythunk *) yythunks= 0;
+YY_VARIABLE(int	     ) yythunkslen= 0;
+YY_VARIABLE(int      ) yythunkpos= 0;
+YY_VARIABLE(YYSTYPE  ) yy;
+YY_VARIABLE(YYSTYPE *) yyval= 0;
+YY_VARIABLE(YYSTYPE *) yyvals= 0;
+YY_VARIABLE(int      ) yyvalslen= 0;
+#ifdef YY_MEMO
+YY_VARIABLE(yymemo * ) yymemos= 0;
+YY_VARIABLE(int      ) yymemoslen= 0;
+YY_VARIABLE(int      ) yymemoscount= 0;
+YY_VARIABLE(yythunk *) yymemothunks= 0;
+YY_VARIABLE(int      ) yymemothunkslen= 0;
+YY_VARIABLE(int      ) yymemothunkpos= 0;
+YY_VARIABLE(int      ) yymemogen= 0;
+#endif
+#ifdef YY_PROFILE
+YY_VARIABLE(yyprofile) yyprofiles[YYRULECOUNT + 1];
+#endif
+#ifdef YY_BUFFER
+YY_VARIABLE(void *   ) yymap= 0;
+YY_VARIABLE(size_t   ) yymaplen= 0;
+#endif
+
+#endif /* YY_CTX_LOCAL */
+
+#ifdef YY_BUFFER
+
+/* the whole input is already in yybuf[0 .. yylimit) */
+#define yyrefill(ctx)	0
+
+#else
+
+YY_LOCAL(int) yyrefill(YY_CTX_PARAM)
+{
+  int yyn;
+  while (yybuflen - yylimit <= YY_READ_SIZE)
+    {
+      yybuflen *= 2;
+      yybuf= realloc(yybuf, yybuflen);
+    }
+  YY_INPUT((yybuf + yylimit), yyn, YY_READ_SIZE);
+  if (!yyn) return 0;
+  yylimit += yyn;
+  return 1;
+}
+
+#endif /* YY_BUFFER */
+
+YY_LOCAL(int) yymatchDot(YY_CTX_PARAM)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  ++yypos;
+  return 1;
+}
+
+YY_LOCAL(int) yymatchChar(YY_CTX_PARAM_ int c)
+{
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  if (yybuf[yypos] == c)
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchChar(%c) @ %s\n", c, yybuf+yypos));
+  return 0;
+}
+
+YY_LOCAL(int) yymatchString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      if (yybuf[yypos] != *s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+/* s is in lower case and matches letters of either case */
+YY_LOCAL(int) yymatchCaselessString(YY_CTX_PARAM_ char *s)
+{
+  int yysav= yypos, yyc;
+  while (*s)
+    {
+      if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))
+	{
+	  yypos= yysav;
+	  return 0;
+	}
+      yyc= (unsigned char)yybuf[yypos];
+      if (yyc >= 'A' && yyc <= 'Z') yyc |= 0x20;
+      if (yyc != (unsigned char)*s)
+        {
+          yypos= yysav;
+          return 0;
+        }
+      ++s;
+      ++yypos;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yymatchClass(YY_CTX_PARAM_ unsigned char *bits)
+{
+  int c;
+  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) return 0;
+  c= (unsigned char)yybuf[yypos];
+  if (bits[c >> 3] & (1 << (c & 7)))
+    {
+      ++yypos;
+      yyprintf((stderr, "  ok   yymatchClass @ %s\n", yybuf+yypos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchClass @ %s\n", yybuf+yypos));
+  return 0;
+}
+
+/* c is in the class whose nibble table (see yyspanClass) is n */
+#define yyinclass(n, c)	((n)[((c) >> 7) * 16 + ((c) & 15)] & (1 << (((c) >> 4) & 7)))
+
+YY_LOCAL(int) yyspanDot(YY_CTX_PARAM)
+{
+  int yysav= yypos;
+  do yypos= yylimit;
+  while (yyrefill(YY_CTX_ARG));
+  return yypos - yysav;
+}
+
+YY_LOCAL(int) yyspanChar(YY_CTX_PARAM_ int c)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSE2__
+      __m128i yyc= _mm_set1_epi8(c);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(yyin, yyc)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	if (yybuf[yypos] != c) return yypos - yysav;
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyscanChar(YY_CTX_PARAM_ int c)
+{
+  for (;;)
+    {
+      char *yyp= memchr(yybuf + yypos, c, yylimit - yypos);
+      if (yyp)
+	{
+	  yypos= yyp - yybuf;
+	  return;
+	}
+      yypos= yylimit;
+      if (!yyrefill(YY_CTX_ARG)) return;
+    }
+}
+
+/*
+ * The class is given as a nibble table: bit (c >> 4) & 7 of byte
+ * (c >> 7) * 16 + (c & 15) is set if c is in the class.  With SSSE3 the
+ * table is indexed by the low nibbles of sixteen characters at once.
+ */
+YY_LOCAL(int) yyspanClass(YY_CTX_PARAM_ unsigned char *nibbles)
+{
+  int yysav= yypos;
+  for (;;)
+    {
+#ifdef __SSSE3__
+      __m128i yylow= _mm_loadu_si128((__m128i *)nibbles);
+      __m128i yyhigh= _mm_loadu_si128((__m128i *)(nibbles + 16));
+      __m128i yybits= _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      __m128i yymask= _mm_set1_epi8(15);
+      while (yylimit - yypos >= 16)
+	{
+	  __m128i yyin= _mm_loadu_si128((__m128i *)(yybuf + yypos));
+	  __m128i yylo= _mm_and_si128(yyin, yymask);
+	  __m128i yyhi= _mm_and_si128(_mm_srli_epi16(yyin, 4), yymask);
+	  __m128i yyupper= _mm_cmpgt_epi8(yyhi, _mm_set1_epi8(7));
+	  __m128i yyrow= _mm_or_si128(_mm_andnot_si128(yyupper, _mm_shuffle_epi8(yylow, yylo)),
+				      _mm_and_si128(yyupper, _mm_shuffle_epi8(yyhigh, yylo)));
+	  __m128i yybit= _mm_shuffle_epi8(yybits, yyhi);
+	  int yymiss= ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(yyrow, yybit), yybit)) & 0xffff;
+	  if (yymiss) return (yypos += __builtin_ctz(yymiss)) - yysav;
+	  yypos += 16;
+	}
+#endif
+      for (;  yypos < yylimit;  ++yypos)
+	{
+	  int c= (unsigned char)yybuf[yypos];
+	  if (!yyinclass(nibbles, c)) return yypos - yysav;
+	}
+      if (!yyrefill(YY_CTX_ARG)) return yypos - yysav;
+    }
+}
+
+YY_LOCAL(void) yyDo(YY_CTX_PARAM_ yyaction action, int begin, int end)
+{
+  while (yythunkpos >= yythunkslen)
+    {
+      yythunkslen *= 2;
+      yythunks= realloc(yythunks, sizeof(yythunk) * yythunkslen);
+    }
+  yythunks[yythunkpos].begin=  begin;
+  yythunks[yythunkpos].end=    end;
+  yythunks[yythunkpos].action= action;
+  ++yythunkpos;
+}
+
+YY_LOCAL(int) yyText(YY_CTX_PARAM_ int begin, int end)
+{
+  int yyleng= end - begin;
+  if (yyleng <= 0)
+    yyleng= 0;
+  else
+    {
+      while (yytextlen < (yyleng + 1))
+	{
+	  yytextlen *= 2;
+	  yytext= realloc(yytext, yytextlen);
+	}
+      memcpy(yytext, yybuf + begin, yyleng);
+    }
+  yytext[yyleng]= '\0';
+  return yyleng;
+}
+
+YY_LOCAL(void) yyDone(YY_CTX_PARAM)
+{
+  int pos;
+  for (pos= 0;  pos < yythunkpos;  ++pos)
+    {
+      yythunk *thunk= &yythunks[pos];
+      int yyleng= thunk->end ? yyText(YY_CTX_ARG_ thunk->begin, thunk->end) : thunk->begin;
+      yyprintf((stderr, "DO [%d] %p %s\n", pos, thunk->action, yytext));
+      thunk->action(YY_CTX_ARG_ yytext, yyleng);
+    }
+  yythunkpos= 0;
+}
+
+#ifdef YY_MEMO
+
+YY_LOCAL(yymemo *) yyMemoFind(YY_CTX_PARAM_ int rule, int pos)
+{
+  unsigned mask= yymemoslen - 1;
+  unsigned h= ((unsigned)pos * YYRULECOUNT + rule) * 2654435761u & mask;
+  while (yymemos[h].rule && (yymemos[h].rule != rule || yymemos[h].pos != pos))
+    h= (h + 1) & mask;
+  return &yymemos[h];
+}
+
+YY_LOCAL(void) yyMemoGrow(YY_CTX_PARAM)
+{
+  yymemo *old= yymemos;
+  int oldlen= yymemoslen, i;
+  yymemoslen *= 2;
+  yymemos= calloc(yymemoslen, sizeof(yymemo));
+  for (i= 0;  i < oldlen;  ++i)
+    if (old[i].rule)
+      *yyMemoFind(YY_CTX_ARG_ old[i].rule, old[i].pos)= old[i];
+  free(old);
+}
+
+YY_LOCAL(void) yyMemoReset(YY_CTX_PARAM)
+{
+  if (yymemoscount)
+    memset(yymemos, 0, sizeof(yymemo) * yymemoslen);
+  yymemoscount= yymemothunkpos= 0;
+  ++yymemogen;
+}
+
+YY_LOCAL(int) yyMemoEnter(YY_CTX_PARAM_ yymemoframe *frame, int rule)
+{
+  yymemo *memo= yyMemoFind(YY_CTX_ARG_ rule, yypos);
+  frame->rule= rule;
+  frame->pos= yypos;
+  frame->thunkpos= yythunkpos;
+  frame->begin= yybegin;
+  frame->end= yyend;
+  frame->gen= yymemogen;
+  if (!memo->rule) return 0;
+  yyprintf((stderr, "  memo %d @ %d -> %d\n", rule, yypos, memo->end));
+  if ((frame->result= (memo->end >= 0)))
+    {
+      int i;
+      for (i= 0;  i < memo->count;  ++i)
+	{
+	  yythunk *thunk= &yymemothunks[memo->thunk + i];
+	  yyDo(YY_CTX_ARG_ thunk->action, thunk->begin, thunk->end);
+	}
+      if (memo->begin >= 0) yybegin= memo->begin;
+      if (memo->endtext >= 0) yyend= memo->endtext;
+      yypos= memo->end;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yyMemoLeave(YY_CTX_PARAM_ yymemoframe *frame, int ok)
+{
+  yymemo *memo;
+  if (frame->gen != yymemogen) return ok;
+  if (2 * (yymemoscount + 1) > yymemoslen) yyMemoGrow(YY_CTX_ARG);
+  memo= yyMemoFind(YY_CTX_ARG_ frame->rule, frame->pos);
+  memo->rule= frame->rule;
+  memo->pos= frame->pos;
+  memo->end= memo->begin= memo->endtext= -1;
+  memo->thunk= yymemothunkpos;
+  memo->count= 0;
+  ++yymemoscount;
+  if (ok)
+    {
+      int count= yythunkpos - frame->thunkpos;
+      while (yymemothunkpos + count > yymemothunkslen)
+	{
+	  yymemothunkslen *= 2;
+	  yymemothunks= realloc(yymemothunks, sizeof(yythunk) * yymemothunkslen);
+	}
+      memcpy(yymemothunks + yymemothunkpos, yythunks + frame->thunkpos, sizeof(yythunk) * count);
+      yymemothunkpos += count;
+      memo->count= count;
+      memo->end= yypos;
+      if (yybegin != frame->begin) memo->begin= yybegin;
+      if (yyend != frame->end) memo->endtext= yyend;
+    }
+  return ok;
+}
+
+#endif /* YY_MEMO */
+
+YY_LOCAL(void) yyCommit(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yybuf += yypos;
+  yylimit -= yypos;
+#else
+  if ((yylimit -= yypos))
+    {
+      memmove(yybuf, yybuf + yypos, yylimit);
+    }
+#endif
+#ifdef YY_MEMO
+  yyMemoReset(YY_CTX_ARG);
+#endif
+  yybegin -= yypos;
+  yyend -= yypos;
+  yypos= yythunkpos= 0;
+}
+
+YY_LOCAL(int) yyAccept(YY_CTX_PARAM_ int tp0)
+{
+  if (tp0)
+    {
+      fprintf(stderr, "accept denied at %d\n", tp0);
+      return 0;
+    }
+  else
+    {
+      yyDone(YY_CTX_ARG);
+      yyCommit(YY_CTX_ARG);
+    }
+  return 1;
+}
+
+YY_LOCAL(void) yyPush(YY_CTX_PARAM_ char *text, int count)	{ yyval += count; }
+YY_LOCAL(void) yyPop(YY_CTX_PARAM_ char *text, int count)	{ yyval -= count; }
+YY_LOCAL(void) yySet(YY_CTX_PARAM_ char *text, int count)	{ yyval[count]= yy; }
+
+#endif /* YY_PART */
+
+#define	YYACCEPT	yyAccept(YY_CTX_ARG_ yythunkpos0)
+
+YY_RULE(int) yy_NUMBER(YY_CTX_PARAM); /* 14 */
+YY_RULE(int) yy_Value(YY_CTX_PARAM); /* 11 */
+YY_RULE(int) yy_Product(YY_CTX_PARAM); /* 8 */
+YY_RULE(int) yy_Sum(YY_CTX_PARAM); /* 7 */
+YY_RULE(int) yy_ID(YY_CTX_PARAM); /* 5 */
+YY_RULE(int) yy_Expr(YY_CTX_PARAM); /* 3 */
+YY_RULE(int) yy_Stmt(YY_CTX_PARAM); /* 1 */
+
+#ifdef YY_CTX_LOCAL
+#undef yytext
+#endif
+YY_ACTION(void) yy_1_ID(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_ID\n"));
+   yy= yytext[0] - 'a'; ;
+}
+YY_ACTION(void) yy_1_NUMBER(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+  yyprintf((stderr, "do yy_1_NUMBER\n"));
+   yy= atoi(yytext); ;
+}
+YY_ACTION(void) yy_3_Value(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define i yyval[-1]
+  yyprintf((stderr, "do yy_3_Value\n"));
+   yy= i; ;
+#undef i
+}
+YY_ACTION(void) yy_2_Value(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define i yyval[-1]
+  yyprintf((stderr, "do yy_2_Value\n"));
+   yy= vars[i]; ;
+#undef i
+}
+YY_ACTION(void) yy_1_Value(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define i yyval[-1]
+  yyprintf((stderr, "do yy_1_Value\n"));
+   yy= atoi(yytext); ;
+#undef i
+}
+YY_ACTION(void) yy_3_Product(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_3_Product\n"));
+   yy= l; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_Product(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_2_Product\n"));
+   l /= r; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_1_Product(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_1_Product\n"));
+   l *= r; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_3_Sum(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_3_Sum\n"));
+   yy= l; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_Sum(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_2_Sum\n"));
+   l -= r; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_1_Sum(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define r yyval[-1]
+#define l yyval[-2]
+  yyprintf((stderr, "do yy_1_Sum\n"));
+   l += r; ;
+#undef r
+#undef l
+}
+YY_ACTION(void) yy_2_Expr(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define i yyval[-2]
+  yyprintf((stderr, "do yy_2_Expr\n"));
+   yy= s; ;
+#undef s
+#undef i
+}
+YY_ACTION(void) yy_1_Expr(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define s yyval[-1]
+#define i yyval[-2]
+  yyprintf((stderr, "do yy_1_Expr\n"));
+   yy= vars[i]= s; ;
+#undef s
+#undef i
+}
+YY_ACTION(void) yy_2_Stmt(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_2_Stmt\n"));
+   printf("error\n"); ;
+#undef e
+}
+YY_ACTION(void) yy_1_Stmt(YY_CTX_PARAM_ char *yytext, int yyleng)
+{
+#define e yyval[-1]
+  yyprintf((stderr, "do yy_1_Stmt\n"));
+   printf("%d\n", e); ;
+#undef e
+}
+#ifdef YY_CTX_LOCAL
+#define yytext		(yyctx->__text)
+#endif
+
+YY_RULE(int) yy_NUMBER(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "NUMBER"));  if (!(YY_BEGIN)) goto l1;  if (!yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x08\x08\x08\x08\x08\x08\x08\x08\x08\x08\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00")) goto l1;  if (!(YY_END)) goto l1;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_NUMBER, yybegin, yyend);
+  yyprintf((stderr, "  ok   %s @ %s\n", "NUMBER", yybuf+yypos));
+  return 1;
+  l1:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "NUMBER", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_Value(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "Value"));
+  {  int yypos3= yypos, yythunkpos3= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l4;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+  case '8': case '9':  if (!yy_NUMBER(YY_CTX_ARG)) goto l4;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_Value, yybegin, yyend);  goto l3;
+  case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g': case 'h':
+  case 'i': case 'j': case 'k': case 'l': case 'm': case 'n': case 'o': case 'p':
+  case 'q': case 'r': case 's': case 't': case 'u': case 'v': case 'w': case 'x':
+  case 'y': case 'z':  if (!yy_ID(YY_CTX_ARG)) goto l4;  yyDo(YY_CTX_ARG_ yySet, -1, 0);
+  {  int yypos5= yypos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l5;
+  {  if ((unsigned char)yybuf[yypos + 0] != '=') goto l5;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yypos= yypos5;  goto l4;
+  l5:;	
+  }  yyDo(YY_CTX_ARG_ yy_2_Value, 0, 0);  goto l3;
+  case '(':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l4;
+  {  if ((unsigned char)yybuf[yypos + 0] != '(') goto l4;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Expr(YY_CTX_ARG)) goto l4;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l4;
+  {  if ((unsigned char)yybuf[yypos + 0] != ')') goto l4;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_3_Value, 0, 0);  goto l3;
+  default:  goto l4;
+  }
+  l4:;	  yypos= yypos3; yythunkpos= yythunkpos3;  goto l2;
+  }
+  l3:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "Value", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l2:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "Value", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_Product(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "Product"));  if (!yy_Value(YY_CTX_ARG)) goto l6;  yyDo(YY_CTX_ARG_ yySet, -2, 0);
+  l7:;	
+  {  int yypos8= yypos, yythunkpos8= yythunkpos;
+  {  int yypos9= yypos, yythunkpos9= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l10;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '*':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l10;
+  {  if ((unsigned char)yybuf[yypos + 0] != '*') goto l10;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Value(YY_CTX_ARG)) goto l10;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_Product, 0, 0);  goto l9;
+  case '/':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l10;
+  {  if ((unsigned char)yybuf[yypos + 0] != '/') goto l10;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Value(YY_CTX_ARG)) goto l10;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_Product, 0, 0);  goto l9;
+  default:  goto l10;
+  }
+  l10:;	  yypos= yypos9; yythunkpos= yythunkpos9;  goto l8;
+  }
+  l9:;	  goto l7;
+  l8:;	  yypos= yypos8; yythunkpos= yythunkpos8;
+  }  yyDo(YY_CTX_ARG_ yy_3_Product, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "Product", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l6:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "Product", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_Sum(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "Sum"));  if (!yy_Product(YY_CTX_ARG)) goto l11;  yyDo(YY_CTX_ARG_ yySet, -2, 0);
+  l12:;	
+  {  int yypos13= yypos, yythunkpos13= yythunkpos;
+  {  int yypos14= yypos, yythunkpos14= yythunkpos;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG))  goto l15;
+  switch ((unsigned char)yybuf[yypos])
+  {
+  case '+':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l15;
+  {  if ((unsigned char)yybuf[yypos + 0] != '+') goto l15;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Product(YY_CTX_ARG)) goto l15;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_Sum, 0, 0);  goto l14;
+  case '-':  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l15;
+  {  if ((unsigned char)yybuf[yypos + 0] != '-') goto l15;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Product(YY_CTX_ARG)) goto l15;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_Sum, 0, 0);  goto l14;
+  default:  goto l15;
+  }
+  l15:;	  yypos= yypos14; yythunkpos= yythunkpos14;  goto l13;
+  }
+  l14:;	  goto l12;
+  l13:;	  yypos= yypos13; yythunkpos= yythunkpos13;
+  }  yyDo(YY_CTX_ARG_ yy_3_Sum, 0, 0);
+  yyprintf((stderr, "  ok   %s @ %s\n", "Sum", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l11:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "Sum", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_ID(YY_CTX_PARAM)
+{
+  yyprintf((stderr, "%s\n", "ID"));  if (!(YY_BEGIN)) goto l16;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l16;  { int yyc= (unsigned char)yybuf[yypos];  if (!((yyc >= 'a' && yyc <= 'z'))) goto l16; }  ++yypos;  if (!(YY_END)) goto l16;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  yyDo(YY_CTX_ARG_ yy_1_ID, yybegin, yyend);
+  yyprintf((stderr, "  ok   %s @ %s\n", "ID", yybuf+yypos));
+  return 1;
+  l16:;	
+  yyprintf((stderr, "  fail %s @ %s\n", "ID", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_Expr(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "Expr"));
+  {  int yypos18= yypos, yythunkpos18= yythunkpos;  if (!yy_ID(YY_CTX_ARG)) goto l19;  yyDo(YY_CTX_ARG_ yySet, -2, 0);  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l19;
+  {  if ((unsigned char)yybuf[yypos + 0] != '=') goto l19;  yypos += 1;
+  }  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Sum(YY_CTX_ARG)) goto l19;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_1_Expr, 0, 0);  goto l18;
+  l19:;	  yypos= yypos18; yythunkpos= yythunkpos18;  if (!yy_Sum(YY_CTX_ARG)) goto l17;  yyDo(YY_CTX_ARG_ yySet, -1, 0);  yyDo(YY_CTX_ARG_ yy_2_Expr, 0, 0);
+  }
+  l18:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "Expr", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 2, 0);
+  return 1;
+  l17:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "Expr", yybuf+yypos));
+  return 0;
+}
+YY_RULE(int) yy_Stmt(YY_CTX_PARAM)
+{  int yypos0= yypos, yythunkpos0= yythunkpos;  yyDo(YY_CTX_ARG_ yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "Stmt"));
+  {  int yypos21= yypos, yythunkpos21= yythunkpos;  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\x04\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");  if (!yy_Expr(YY_CTX_ARG)) goto l22;  yyDo(YY_CTX_ARG_ yySet, -1, 0);
+  {  int yyrmarker= yypos, yyraccept= 0;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l23;
+  switch ((unsigned char)yybuf[yypos++])
+  {
+  case 0x0a:  goto l24;
+  case 0x0d:  yyrmarker= yypos;  yyraccept= 1;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l23;  if ((unsigned char)yybuf[yypos + 0] != 0x0a) goto l23;  ++yypos;  goto l24;
+  case ';':  goto l24;
+  default:  goto l23;
+  }
+  l23:;	  yypos= yyrmarker;  if (!yyraccept)  goto l22;
+  l24:;	
+  }  yyDo(YY_CTX_ARG_ yy_1_Stmt, 0, 0);  goto l21;
+  l22:;	  yypos= yypos21; yythunkpos= yythunkpos21;
+  l25:;	  yyspanClass(YY_CTX_ARG_ (unsigned char *)"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe\xf7\xff\xfe\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff");
+  {  int yypos26= yypos;
+  {  int yyrmarker= yypos, yyraccept= 0;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l28;
+  switch ((unsigned char)yybuf[yypos++])
+  {
+  case 0x0a:  goto l29;
+  case 0x0d:  yyrmarker= yypos;  yyraccept= 1;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l28;  if ((unsigned char)yybuf[yypos + 0] != 0x0a) goto l28;  ++yypos;  goto l29;
+  case ';':  goto l29;
+  default:  goto l28;
+  }
+  l28:;	  yypos= yyrmarker;  if (!yyraccept)  goto l26;
+  l29:;	
+  }  yypos= yypos26;  goto l27;
+  l26:;	
+  }  if (!yymatchDot(YY_CTX_ARG))  goto l27;  goto l25;
+  l27:;	
+  {  int yyrmarker= yypos, yyraccept= 0;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l30;
+  switch ((unsigned char)yybuf[yypos++])
+  {
+  case 0x0a:  goto l31;
+  case 0x0d:  yyrmarker= yypos;  yyraccept= 1;  if (yypos >= yylimit && !yyrefill(YY_CTX_ARG)) goto l30;  if ((unsigned char)yybuf[yypos + 0] != 0x0a) goto l30;  ++yypos;  goto l31;
+  case ';':  goto l31;
+  default:  goto l30;
+  }
+  l30:;	  yypos= yyrmarker;  if (!yyraccept)  goto l20;
+  l31:;	
+  }  yyDo(YY_CTX_ARG_ yy_2_Stmt, 0, 0);
+  }
+  l21:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "Stmt", yybuf+yypos));  yyDo(YY_CTX_ARG_ yyPop, 1, 0);
+  return 1;
+  l20:;	  yypos= yypos0; yythunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "Stmt", yybuf+yypos));
+  return 0;
+}
+
+#ifndef YY_PART
+
+typedef int (*yyrule)(YY_CTX_PARAM);
+
+YY_PARSE(int) YYPARSEFROM(YY_CTX_PARAM_ yyrule yystart)
+{
+  int yyok;
+  if (!yybuflen)
+    {
+      yybuflen= 1024;
+#ifndef YY_BUFFER
+      yybuf= malloc(yybuflen);
+#endif
+      yytextlen= 1024;
+      yytext= malloc(yytextlen);
+      yythunkslen= YY_STACK_SIZE;
+      yythunks= malloc(sizeof(yythunk) * yythunkslen);
+      yyvalslen= YY_STACK_SIZE;
+      yyvals= malloc(sizeof(YYSTYPE) * yyvalslen);
+#ifdef YY_MEMO
+      yymemoslen= 1024;
+      yymemos= calloc(yymemoslen, sizeof(yymemo));
+      yymemothunkslen= YY_STACK_SIZE;
+      yymemothunks= malloc(sizeof(yythunk) * yymemothunkslen);
+#endif
+#ifdef YY_BUFFER
+      yybegin= yyend= yythunkpos= 0;	/* yybuf, yypos and yylimit were set by YYPARSEBUFFER */
+#else
+      yybegin= yyend= yypos= yylimit= yythunkpos= 0;
+#endif
+    }
+  yybegin= yyend= yypos;
+  yythunkpos= 0;
+  yyval= yyvals;
+  yyok= yystart(YY_CTX_ARG);
+  if (yyok) yyDone(YY_CTX_ARG);
+  yyCommit(YY_CTX_ARG);
+  return yyok;
+#ifndef YY_BUFFER
+  (void)yyrefill;
+#endif
+  (void)yymatchDot;
+  (void)yymatchChar;
+  (void)yymatchString;
+  (void)yymatchCaselessString;
+  (void)yymatchClass;
+  (void)yyspanDot;
+  (void)yyspanChar;
+  (void)yyspanClass;
+  (void)yyscanChar;
+  (void)yyDo;
+  (void)yyText;
+  (void)yyDone;
+  (void)yyCommit;
+  (void)yyAccept;
+  (void)yyPush;
+  (void)yyPop;
+  (void)yySet;
+  (void)yytextmax;
+}
+
+YY_PARSE(int) YYPARSE(YY_CTX_PARAM)
+{
+  return YYPARSEFROM(YY_CTX_ARG_ yy_Stmt);
+}
+
+#ifdef YY_BUFFER
+
+YY_LOCAL(void) yyunmap(YY_CTX_PARAM)
+{
+  if (yymap)
+    {
+      munmap(yymap, yymaplen);
+      yymap= 0;
+      yymaplen= 0;
+    }
+}
+
+YY_PARSE(int) YYPARSEBUFFER(YY_CTX_PARAM_ const char *data, size_t len)
+{
+  if (len > INT_MAX)
+    {
+      errno= EOVERFLOW;
+      return -1;
+    }
+  yybuf= (char *)data;
+  yylimit= len;
+  yybegin= yyend= yypos= 0;
+  return YYPARSE(YY_CTX_ARG);
+}
+
+YY_PARSE(int) YYPARSEFILE(YY_CTX_PARAM_ const char *path)
+{
+  struct stat st;
+  void *map= 0;
+  int fd;
+  if ((fd= open(path, O_RDONLY)) < 0)
+    return -1;
+  if (fstat(fd, &st) < 0
+      || (st.st_size > INT_MAX && (errno= EOVERFLOW))
+      || (st.st_size && MAP_FAILED == (map= mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))))
+    {
+      close(fd);
+      return -1;
+    }
+  close(fd);
+  yyunmap(YY_CTX_ARG);
+  yymap= map;
+  yymaplen= st.st_size;
+  return YYPARSEBUFFER(YY_CTX_ARG_ map ? (char *)map : "", st.st_size);
+}
+
+#endif /* YY_BUFFER */
+
+#ifdef YY_PROFILE
+
+YY_LOCAL(int) yyprofilecmp(const void *a, const void *b)
+{
+  const yyprofile *p= a, *q= b;
+  if (p->calls != q->calls) return p->calls < q->calls ? 1 : -1;
+  return strcmp(p->name, q->name);
+}
+
+YY_PARSE(void) YYPROFILEDUMP(YY_CTX_PARAM_ FILE *stream)
+{
+  yyprofile yyreport[YYRULECOUNT];
+  int i;
+  for (i= 0;  i < YYRULECOUNT;  ++i)
+    {
+      yyreport[i]= yyprofiles[i + 1];
+      yyreport[i].name= yyrulenames[i + 1];
+    }
+  qsort(yyreport, YYRULECOUNT, sizeof(yyprofile), yyprofilecmp);
+  fprintf(stream, "%12s %12s %12s %14s %14s  %s\n",
+	  "calls", "succeeded", "failed", "consumed", "backtracked", "rule");
+  for (i= 0;  i < YYRULECOUNT && yyreport[i].calls;  ++i)
+    fprintf(stream, "%12lu %12lu %12lu %14lu %14lu  %s\n",
+	    yyreport[i].calls, yyreport[i].succeeded, yyreport[i].failed,
+	    yyreport[i].consumed, yyreport[i].backtracked, yyreport[i].name);
+}
+
+#endif /* YY_PROFILE */
+
+YY_PARSE(void) YYRELEASE(YY_CTX_PARAM)
+{
+#ifdef YY_BUFFER
+  yyunmap(YY_CTX_ARG);
+#endif
+  if (yybuflen)
+    {
+#ifndef YY_BUFFER
+      free(yybuf);
+#endif
+      free(yytext);
+      free(yythunks);
+      free(yyvals);
+#ifdef YY_MEMO
+      free(yymemos);
+      free(yymemothunks);
+#endif
+      yybuflen= 0;
+    }
+}
+
+#endif
+
+
+int main()
+{
+  while (yyparse());
+
+  return 0;
+}
+
@@ -9,6 +9,7 @@
 
 #include "tree.h"
 #include "version.h"
+#include "optimize.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -43,12 +44,24 @@ void makeTrailer(char *text);
 
 void yyerror(char *message);
 
-#define YY_INPUT(buf, result, max)		\
-  {						\
-    int c= getc(input);				\
-    if ('\n' == c || '\r' == c) ++lineNumber;	\
-    result= (EOF == c) ? 0 : (*(buf)= c, 1);	\
-  }
+/*
+ * Input is read a line at a time so that lineNumber still tracks the
+ * furthest text the parser has looked at.
+ */
+static int readLine(char *buf, int max)
+{
+    int length, i;
+
+    if (!fgets(buf, max, input))
+        return 0;
+    length = strlen(buf);
+    for (i = 0; i < length; ++i)
+        if ('\n' == buf[i] || '\r' == buf[i])
+            ++lineNumber;
+    return length;
+}
+
+#define YY_INPUT(buf, result, max)	result= readLine((buf), (max))
 
 #define YY_LOCAL(T)	static T
 #define YY_RULE(T)	static T
@@ -241,7 +254,7 @@ YY_LOCAL(int) yyText(int begin, int end)
         yyleng = 0;
     else
     {
-        while (yytextlen < (yyleng - 1))
+        while (yytextlen < (yyleng + 1))
         {
             yytextlen *= 2;
             yytext = realloc(yytext, yytextlen);
@@ -386,40 +399,46 @@ YY_RULE(int) yy__();            /* 2 */
 
 YY_RULE(int) yy_grammar();      /* 1 */
 
+YY_ACTION(void) yy_10_primary(char *yytext, int yyleng)
+{
+    yyprintf((stderr, "do yy_10_primary\n"));
+    push(makePredicate("YY_END"));;
+}
+
 YY_ACTION(void) yy_9_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_9_primary\n"));
-    push(makePredicate("YY_END"));;
+    push(makePredicate("YY_BEGIN"));;
 }
 
 YY_ACTION(void) yy_8_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_8_primary\n"));
-    push(makePredicate("YY_BEGIN"));;
+    push(makeAction(yytext));;
 }
 
 YY_ACTION(void) yy_7_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_7_primary\n"));
-    push(makeAction(yytext));;
+    push(makeDot());;
 }
 
 YY_ACTION(void) yy_6_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_6_primary\n"));
-    push(makeDot());;
+    push(makeClass(yytext));;
 }
 
 YY_ACTION(void) yy_5_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_5_primary\n"));
-    push(makeClass(yytext));;
+    push(makeString(yytext));;
 }
 
 YY_ACTION(void) yy_4_primary(char *yytext, int yyleng)
 {
     yyprintf((stderr, "do yy_4_primary\n"));
-    push(makeString(yytext));;
+    push(makeCaselessString(yytext));;
 }
 
 YY_ACTION(void) yy_3_primary(char *yytext, int yyleng)
@@ -946,8 +965,6 @@ YY_RULE(int)yy_literal()
             ((unsigned char *)
              "\000\000\000\000\200\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000"))
             goto l40;
-        if (!yy__())
-            goto l40;
         goto l39;
       l40:;
         yypos = yypos39;
@@ -989,8 +1006,6 @@ YY_RULE(int)yy_literal()
             ((unsigned char *)
              "\000\000\000\000\004\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000"))
             goto l38;
-        if (!yy__())
-            goto l38;
     }
   l39:;
     yyprintf((stderr, "  ok   %s @ %s\n", "literal", yybuf + yypos));
@@ -1169,42 +1184,67 @@ YY_RULE(int)yy_primary()
         yythunkpos = yythunkpos54;
         if (!yy_literal())
             goto l60;
+        if (!yymatchChar('i'))
+            goto l60;
+        {
+            int yypos137 = yypos, yythunkpos137 = yythunkpos;
+
+            if (!yymatchClass
+                ((unsigned char *)
+                 "\000\000\000\000\000\040\377\003\376\377\377\207\376\377\377\007\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000"))
+                goto l137;
+            goto l60;
+          l137:;
+            yypos = yypos137;
+            yythunkpos = yythunkpos137;
+        }
+        if (!yy__())
+            goto l60;
         yyDo(yy_4_primary, yybegin, yyend);
         goto l54;
       l60:;
+        yypos = yypos54;
+        yythunkpos = yythunkpos54;
+        if (!yy_literal())
+            goto l138;
+        if (!yy__())
+            goto l138;
+        yyDo(yy_5_primary, yybegin, yyend);
+        goto l54;
+      l138:;
         yypos = yypos54;
         yythunkpos = yythunkpos54;
         if (!yy_class())
             goto l61;
-        yyDo(yy_5_primary, yybegin, yyend);
+        yyDo(yy_6_primary, yybegin, yyend);
         goto l54;
       l61:;
         yypos = yypos54;
         yythunkpos = yythunkpos54;
         if (!yy_DOT())
             goto l62;
-        yyDo(yy_6_primary, yybegin, yyend);
+        yyDo(yy_7_primary, yybegin, yyend);
         goto l54;
       l62:;
         yypos = yypos54;
         yythunkpos = yythunkpos54;
         if (!yy_action())
             goto l63;
-        yyDo(yy_7_primary, yybegin, yyend);
+        yyDo(yy_8_primary, yybegin, yyend);
         goto l54;
       l63:;
         yypos = yypos54;
         yythunkpos = yythunkpos54;
         if (!yy_BEGIN())
             goto l64;
-        yyDo(yy_8_primary, yybegin, yyend);
+        yyDo(yy_9_primary, yybegin, yyend);
         goto l54;
       l64:;
         yypos = yypos54;
         yythunkpos = yythunkpos54;
         if (!yy_END())
             goto l53;
-        yyDo(yy_9_primary, yybegin, yyend);
+        yyDo(yy_10_primary, yybegin, yyend);
     }
   l54:;
     yyprintf((stderr, "  ok   %s @ %s\n", "primary", yybuf + yypos));
@@ -1886,8 +1926,15 @@ static void usage(char *name)
     version(name);
     fprintf(stderr, "usage: %s [<option>...] [<file>...]\n", name);
     fprintf(stderr, "where <option> can be\n");
+    fprintf(stderr, "  -e <rule>   generate <rule> as an entry point for yyparsefrom()\n");
+    fprintf(stderr, "  -f<pass>    run <pass>, or skip it with -fno-<pass>, where <pass> is one of\n");
+    optimizeUsage(stderr);
     fprintf(stderr, "  -h          print this help information\n");
+    fprintf(stderr, "  -m          memoize rule results (packrat parsing)\n");
     fprintf(stderr, "  -o <ofile>  write output to <ofile>\n");
+    fprintf(stderr, "  -O<level>   run the optimization passes of <level> 0, 1 or 2 (default 2)\n");
+    fprintf(stderr, "  -p          count calls, failures and backtracking per rule\n");
+    fprintf(stderr, "  -r          generate a reentrant parser (see YY_CTX_LOCAL)\n");
     fprintf(stderr, "  -v          be verbose\n");
     fprintf(stderr, "  -V          print version number and exit\n");
     fprintf(stderr, "if no <file> is given, input is read from stdin\n");
@@ -1906,18 +1953,43 @@ int main(int argc, char **argv)
     lineNumber = 1;
     fileName = "<stdin>";
 
-    while (-1 != (c = getopt(argc, argv, "Vho:v")))
+    while (-1 != (c = getopt(argc, argv, "O:Ve:f:hmo:prv")))
     {
         switch (c)
         {
+        case 'O':
+            if (!*optarg || optarg[strspn(optarg, "0123456789")])
+            {
+                fprintf(stderr, "%s: bad optimization level '%s'\n", argv[0], optarg);
+                exit(1);
+            }
+            optimizeLevel = atoi(optarg);
+            break;
+
         case 'V':
             version(basename(argv[0]));
             exit(0);
 
+        case 'e':
+            Rule_beEntry(findRule(optarg));
+            break;
+
+        case 'f':
+            if (!optimizeOption(optarg))
+            {
+                fprintf(stderr, "%s: unknown optimization '%s'\n", argv[0], optarg);
+                exit(1);
+            }
+            break;
+
         case 'h':
             usage(basename(argv[0]));
             break;
 
+        case 'm':
+            memoizeFlag = 1;
+            break;
+
         case 'o':
             if (!(output = fopen(optarg, "w")))
             {
@@ -1926,6 +1998,14 @@ int main(int argc, char **argv)
             }
             break;
 
+        case 'p':
+            profileFlag = 1;
+            break;
+
+        case 'r':
+            reentrantFlag = 1;
+            break;
+
         case 'v':
             verboseFlag = 1;
             break;
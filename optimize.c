@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "analyze.h"
 #include "optimize.h"
 #include "set.h"
 #include "tree.h"
@@ -19,6 +20,107 @@ void optimizeAlternate(Node * node);
 void optimizeAlternateStrings(Node * node);
 
 
+/*
+ * A pass runs when the optimization level is at least its own level,
+ * unless -f<name> or -fno-<name> said otherwise (in any order relative
+ * to -O).  Passes that rewrite the grammar count what they rewrite, for
+ * the statistics printed by -v; the others choose how code is generated.
+ */
+static struct
+{
+    const char *name;
+    int level;
+    int setting;                // -1: follow the level, otherwise 0 or 1
+    const char *counts;         // what the count counts, for -v
+    int count;
+} passes[OptCount] =
+{
+    { "inline",            2, -1, "calls inlined" },
+    { "merge-literals",    1, -1, "literals merged" },
+    { "alternate-class",   1, -1, "alternates merged" },
+    { "alternate-strings", 1, -1, "alternates removed" },
+    { "string-table",      1, -1, "string tables built" },
+    { "class-tests",       2, -1 },
+    { "span",              2, -1 },
+    { "scan",              2, -1 },
+    { "left-factor",       2, -1, "prefixes factored" },
+    { "dispatch",          2, -1 },
+    { "literal-runs",      2, -1 },
+    { "merge-rules",       2, -1, "rules merged" },
+    { "dead-rules",        1, -1, "rules removed" },
+    { "lookahead",         1, -1, "lookaheads fused" },
+    { "canonicalize",      1, -1, "nodes rewritten" },
+};
+
+static int rounds = 0;
+
+int optimizeLevel = 2;
+
+int optimizeEnabled(int pass)
+{
+    if (passes[pass].setting >= 0)
+        return passes[pass].setting;
+    return optimizeLevel >= passes[pass].level;
+}
+
+/*
+ * Handle the argument of -f: a pass name, optionally prefixed with no-.
+ * Answers 0 if there is no such pass.
+ */
+int optimizeOption(const char *option)
+{
+    int enable = 1;
+
+    int i;
+
+    if (!strncmp(option, "no-", 3))
+    {
+        enable = 0;
+        option += 3;
+    }
+    for (i = 0; i < OptCount; ++i)
+        if (!strcmp(option, passes[i].name))
+        {
+            passes[i].setting = enable;
+            return 1;
+        }
+    return 0;
+}
+
+void optimizeUsage(FILE *stream)
+{
+    int i;
+
+    for (i = 0; i < OptCount; ++i)
+        fprintf(stream, "%s%s%s", (i % 4) ? " " : "              ", passes[i].name,
+                (i % 4 == 3 || i == OptCount - 1) ? "\n" : "");
+}
+
+static void rewrote(int pass)
+{
+    ++passes[pass].count;
+}
+
+static int rewrites(void)
+{
+    int i, count = 0;
+
+    for (i = 0; i < OptCount; ++i)
+        count += passes[i].count;
+    return count;
+}
+
+void optimizeStatistics(FILE *stream)
+{
+    int i;
+
+    fprintf(stream, "optimized in %d round%s\n", rounds, rounds == 1 ? "" : "s");
+    for (i = 0; i < OptCount; ++i)
+        if (passes[i].counts && optimizeEnabled(i))
+            fprintf(stream, "  %-20s%6d %s\n", passes[i].name, passes[i].count, passes[i].counts);
+}
+
+
 
 
 char *escape(const char *cp, int length)
@@ -117,23 +219,81 @@ char *escape(const char *cp, int length)
                 str[count++] = c;
             else
             {
-                sprintf(&str[count], "\\%03o", c);
+                sprintf(&str[count], "\\%03o", (unsigned char)c);
                 count += 4;
             }
         }
     }
-    str[i] = 0;
+    str[count] = 0;
 
     return str;
 }
 
 
+/*
+ * Inlined copies of a rule repeat its alternates; warn about each string
+ * that can never be matched only once.
+ */
+static void warnNeverMatched(const char *value)
+{
+    static struct Warning
+    {
+        struct Warning *next;
+        const char *value;
+    } *warnings = NULL;
+
+    struct Warning *w;
+
+    for (w = warnings; w; w = w->next)
+        if (!strcmp(w->value, value))
+            return;
+    w = (struct Warning *)malloc(sizeof(struct Warning));
+    w->next = warnings;
+    w->value = strdup(value);
+    warnings = w;
+    fprintf(stderr, "Warning: ``%s'' can never be matched\n", value);
+}
+
 struct LNode
 {
     struct LNode *next;
     struct RawString *string;
 };
 
+/*
+ * Does every input that string t matches begin with a match for string
+ * s?  The letters of a caseless string are all lower case.
+ */
+static int RawString_covers(struct RawString *s, struct RawString *t)
+{
+    int i;
+
+    if (s->length > t->length)
+        return 0;
+    for (i = 0; i < s->length; ++i)
+    {
+        int c = (unsigned char)t->string[i];
+
+        if (s->caseless && !t->caseless)
+            c = tolower(c);
+        else if (!s->caseless && t->caseless && isalpha(c))
+            return 0;
+        if (c != (unsigned char)s->string[i])
+            return 0;
+    }
+    return 1;
+}
+
+static int RawString_hasLetters(struct RawString *s)
+{
+    int i;
+
+    for (i = 0; i < s->length; ++i)
+        if (isalpha((unsigned char)s->string[i]))
+            return 1;
+    return 0;
+}
+
 void optimizeAlternateStrings(Node * node)
 {
     struct LNode *table[256]; // hash by first character of string.
@@ -216,6 +376,8 @@ void optimizeAlternateStrings(Node * node)
                  * so everything afterwards needs to be removed.
                  * memcmp works fine, but the table is hashed by 
                  * the first char, so we need to special case it.
+                 * (hashing by the lower case character keeps caseless
+                 * strings with those they might cover.)
                  */
     
             
@@ -224,8 +386,9 @@ void optimizeAlternateStrings(Node * node)
     
                 if (length)
                 {
-                    c = string->string[0];
-                    if (charClassIsSet(bits, c))
+                    c = tolower((unsigned char)string->string[0]);
+                    if (charClassIsSet(bits, (unsigned char)string->string[0])
+                        && (!string->caseless || charClassIsSet(bits, toupper(c))))
                         remove = 1;
                 }
                 else
@@ -242,13 +405,10 @@ void optimizeAlternateStrings(Node * node)
     
                     for (ln = table[c]; ln; ln = ln->next)
                     {
-                        if (ln->string->length <= length)
+                        if (RawString_covers(ln->string, string))
                         {
-                            if (memcmp(ln->string->string, string->string, ln->string->length) == 0)
-                            {
-                                remove = 1;
-                                break;
-                            }
+                            remove = 1;
+                            break;
                         }
                     }
                 }
@@ -270,7 +430,8 @@ void optimizeAlternateStrings(Node * node)
 
         if (remove)
         {
-            fprintf(stderr, "Warning: ``%s'' can never be matched\n", n->string.value);
+            warnNeverMatched(n->string.value);
+            rewrote(OptAlternateStrings);
             if (prevNode == NULL)
                 node->alternate.first = nextNode;
             // should never happen.
@@ -340,6 +501,7 @@ void optimizeAlternateClass(Node * node)
             charClassOr(n->cclass.bits, nextNode->cclass.bits);
             n->any.next = nextNode->any.next;
             freeNode(nextNode);
+            rewrote(OptAlternateClass);
 
             // prevNode = n;
             // n = n->any.next;
@@ -351,6 +513,7 @@ void optimizeAlternateClass(Node * node)
             charClassSet(n->cclass.bits, nextNode->character.cValue);
             n->any.next = nextNode->any.next;
             freeNode(nextNode);
+            rewrote(OptAlternateClass);
 
             // prevNode = n;
             // n = n->any.next;
@@ -369,6 +532,7 @@ void optimizeAlternateClass(Node * node)
                 prevNode->any.next = n;
             else
                 node->alternate.first = n;
+            rewrote(OptAlternateClass);
 
             continue;
         }
@@ -391,6 +555,7 @@ void optimizeAlternateClass(Node * node)
             freeNode(n);
             freeNode(nextNode);
             n = newNode;
+            rewrote(OptAlternateClass);
 
             continue;
         }
@@ -503,6 +668,7 @@ void optimizeAlternateStringTable(Node * node)
     unsigned count = 0;
     int hasCC = 0;
     int hasEmptyString = 0;
+    int caseless = 0, letters = 0, c;
 
     // for now, only kick in if all children are strings, characters, or
     // ranges.
@@ -543,6 +709,17 @@ void optimizeAlternateStringTable(Node * node)
         {
             if (n->string.rawString->length == 0) hasEmptyString = 1;
             else ++count;
+            // the table matches the longest string, which is only right
+            // if no earlier character can match the start of this one
+            if (n->string.rawString->caseless)
+            {
+                c = (unsigned char)n->string.rawString->string[0];
+                if (!charClassIsSet(bits, c) != !charClassIsSet(bits, toupper(c)))
+                    return;
+                ++caseless;
+            }
+            else
+                letters += RawString_hasLetters(n->string.rawString);
 
             continue;
         }
@@ -555,7 +732,19 @@ void optimizeAlternateStringTable(Node * node)
     if (count + hasCC < 2)
         return;
 
+    // a table either matches every letter in either case or every letter
+    // exactly, so leave a mixture as it is.
+    if (caseless)
+    {
+        if (letters)
+            return;
+        for (c = 'a'; c <= 'z'; ++c)
+            if (!charClassIsSet(bits, c) != !charClassIsSet(bits, toupper(c)))
+                return;
+    }
+
     st = makeStringTable(count);
+    rewrote(OptStringTable);
     if (hasCC)
     {
         st->table.bits = (unsigned char *)malloc(32 * sizeof(char));
@@ -563,6 +752,7 @@ void optimizeAlternateStringTable(Node * node)
     }
 
     st->table.emptyString = hasEmptyString;
+    st->table.caseless = !!caseless;
     
     count = 0;
     for (n = node->alternate.first; n; n = n->any.next)
@@ -604,46 +794,1280 @@ void optimizeAlternateStringTable(Node * node)
 }
 
 
-// todo -- add a simplification phase
-// eg Node *simplify(Node *node) 
-// returns NULL (to delete), node (if unchanged) or new Node
-// called to simplify list elements
-// eg:
-// alternate with no entries -> NULL
-// alternate with one entry -> child entry
-// single char string -> character
-// full class -> dot
+/*
+ * Inlining: a call to a small rule that has no variables, is not
+ * recursive and does not use YYACCEPT (which refers to the saved state
+ * of the function it appears in) is replaced by a copy of the rule's
+ * expression, so the passes below can see across the rule boundary.
+ * A rule is small if its expression is, once the calls in it have been
+ * inlined too, so that chains of small rules cannot multiply in size.
+ * Rules that are inlined at every call site are marked RuleInlined and
+ * no function is generated for them.
+ */
+
+#define INLINE_SIZE 8
+
+static int *ruleSizes = 0;
 
-void optimize(Node * node)
+static int Rule_size(Node * rule);
+
+static int Node_size(Node * node)
 {
     Node *n;
 
-    if (!node)
-        return;
+    int size = 1;
 
     switch (node->type)
     {
-    case Rule:
-        return optimize(node->rule.expression);
+    case Name:
+        n = node->name.rule;
+        if (ruleSizes && !node->name.variable && (RuleInlined & n->rule.flags))
+        {
+            size = Rule_size(n);
+            if (RuleInlined & n->rule.flags)
+                return size;
+            size = 1;
+        }
         break;
 
+    case Alternate:
     case Sequence:
-        for (n = node->alternate.first; n; n = n->alternate.next)
-            optimize(n);
+        for (n = node->alternate.first; n; n = n->any.next)
+            size += Node_size(n);
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        size += Node_size(node->query.element);
         break;
+    }
+    return size;
+}
+
+/*
+ * The size of a rule's expression after inlining, for rules marked
+ * RuleInlined (without ruleSizes, Node_size counts every call as one).
+ * A rule that is too large loses the mark.  Rules that
+ * are marked do not call themselves, so this terminates.
+ */
+static int Rule_size(Node * rule)
+{
+    if (!ruleSizes[rule->rule.id])
+    {
+        ruleSizes[rule->rule.id] = Node_size(rule->rule.expression);
+        if (ruleSizes[rule->rule.id] > INLINE_SIZE)
+            rule->rule.flags &= ~RuleInlined;
+    }
+    return ruleSizes[rule->rule.id];
+}
+
+/*
+ * Does node call the rule, directly or through other rules?  Rules
+ * already visited are marked RuleReached; the caller clears the marks.
+ */
+static int Node_reaches(Node * node, Node * rule)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        n = node->name.rule;
+        if (n == rule)
+            return 1;
+        if (!n->rule.expression || (RuleReached & n->rule.flags))
+            return 0;
+        n->rule.flags |= RuleReached;
+        return Node_reaches(n->rule.expression, rule);
 
     case Alternate:
-        // todo -- pass in/return a pair of start/end nodes
-        // to simplify the insertion/removal logic
-        
-        optimizeAlternateClass(node);
-        optimizeAlternateStrings(node);
-        optimizeAlternateStringTable(node);
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            if (Node_reaches(n, rule))
+                return 1;
+        return 0;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_reaches(node->query.element, rule);
+    }
+    return 0;
+}
+
+/*
+ * Does node use YYACCEPT anywhere?
+ */
+int Node_accepts(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Action:
+        return !!strstr(node->action.text, "YYACCEPT");
+
+    case Predicate:
+        return !!strstr(node->predicate.text, "YYACCEPT");
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            if (Node_accepts(n))
+                return 1;
+        return 0;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_accepts(node->query.element);
+    }
+    return 0;
+}
+
+static Node *inlineNode(Node * node)
+{
+    Node *n, **link, *last;
+
+    switch (node->type)
+    {
+    case Name:
+        n = node->name.rule;
+        if (!node->name.variable && (RuleInlined & n->rule.flags))
+        {
+            Node *copy = inlineNode(Node_copy(n->rule.expression));
+
+            copy->any.next = node->any.next;
+            freeNode(node);
+            rewrote(OptInline);
+            return copy;
+        }
+        break;
+
+    case Alternate:
+    case Sequence:
+        last = 0;
+        for (link = &node->alternate.first; (n = *link); link = &last->any.next)
+        {
+            Node *e = inlineNode(n);
+
+            if (e != n && e->type == node->type)
+            {
+                // splice ( a / b ) into the enclosing alternate, a b into the sequence
+                *link = e->alternate.first;
+                e->alternate.last->any.next = e->any.next;
+                last = e->alternate.last;
+                freeNode(e);
+            }
+            else
+                *link = last = e;
+        }
+        node->alternate.last = last;
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        node->query.element = inlineNode(node->query.element);
+        break;
+    }
+    return node;
+}
+
+static void Node_uninline(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        node->name.rule->rule.flags &= ~RuleInlined;
+        break;
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            Node_uninline(n);
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        Node_uninline(node->query.element);
+        break;
+    }
+}
+
+static void inlineRules(Node * rules)
+{
+    Node *r, *n;
+
+    if (!optimizeEnabled(OptInline))
+        return;
+    for (r = rules; r; r = r->rule.next)
+    {
+        if (!r->rule.expression || r->rule.variables || !(RuleUsed & r->rule.flags)
+            || Node_size(r->rule.expression) > INLINE_SIZE
+            || Node_accepts(r->rule.expression))
+            continue;
+        if (!Node_reaches(r->rule.expression, r))
+            r->rule.flags |= RuleInlined;
+        for (n = rules; n; n = n->rule.next)
+            n->rule.flags &= ~RuleReached;
+    }
+    ruleSizes = calloc(ruleCount + 1, sizeof(int));
+    for (r = rules; r; r = r->rule.next)
+        if (RuleInlined & r->rule.flags)
+            Rule_size(r);
+    free(ruleSizes);
+    ruleSizes = 0;
+    for (r = rules; r; r = r->rule.next)
+        if (r->rule.expression)
+            r->rule.expression = inlineNode(r->rule.expression);
+
+    // anything still called (with a variable), the start rule and the
+    // entry points need their functions
+    if (start)
+        start->rule.flags &= ~RuleInlined;
+    for (r = rules; r; r = r->rule.next)
+        if (RuleEntry & r->rule.flags)
+            r->rule.flags &= ~RuleInlined;
+    for (r = rules; r; r = r->rule.next)
+        if (r->rule.expression && !(RuleInlined & r->rule.flags))
+            Node_uninline(r->rule.expression);
+}
+
+
+/*
+ * Merging: rules without variables whose optimized expressions are
+ * identical are merged, so that calls to one go to the other and only
+ * one function is generated.  Expressions are hashed to find candidates
+ * and compared with Node_equal().  Calls compare equal only when they
+ * call the same rule, so merging two rules can make their callers
+ * identical too; repeat until nothing more merges.  Start and the entry
+ * points must keep their functions and are never merged away.
+ */
+
+static unsigned hashBytes(unsigned hash, const void *bytes, int length)
+{
+    const unsigned char *p = bytes;
+
+    while (length--)
+        hash = (hash ^ *p++) * 16777619;
+    return hash;
+}
+
+static unsigned Node_hash(Node * node)
+{
+    unsigned hash = 2166136261u ^ node->type;
+
+    Node *n;
+
+    int i;
+
+    switch (node->type)
+    {
+    case Name:
+        hash = hashBytes(hash, &node->name.rule->rule.id, sizeof(int));
+        return hash ^ !!node->name.variable;
+
+    case Character:
+        return hashBytes(hash, &node->character.cValue, 1);
+
+    case String:
+        return hashBytes(hash, node->string.rawString->string, node->string.rawString->length);
+
+    case Class:
+        return hashBytes(hash, node->cclass.bits, 32);
+
+    case Action:
+        return hashBytes(hash, node->action.name, strlen(node->action.name));
+
+    case Predicate:
+        return hashBytes(hash, node->predicate.text, strlen(node->predicate.text));
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            hash = (hash ^ Node_hash(n)) * 16777619;
+        return hash;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return (hash ^ Node_hash(node->query.element)) * 16777619;
+
+    case StringTable:
+        for (i = 0; i < node->table.value.count; ++i)
+            hash = hashBytes(hash, node->table.value.strings[i]->string,
+                             node->table.value.strings[i]->length);
+        return hash;
+    }
+    return hash;
+}
+
+static int Rule_removable(Node * rule)
+{
+    return rule != start && !(RuleEntry & rule->rule.flags);
+}
+
+static void Node_redirect(Node * node, Node ** merged)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        while (merged[node->name.rule->rule.id])
+            node->name.rule = merged[node->name.rule->rule.id];
+        break;
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            Node_redirect(n, merged);
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        Node_redirect(node->query.element, merged);
+        break;
+    }
+}
+
+static void mergeRules(Node * rules)
+{
+    Node **table, **merged, *r, *s;
+
+    int size, changed;
+
+    unsigned h;
+
+    if (!optimizeEnabled(OptMergeRules))
+        return;
+    for (size = 16; size < 2 * ruleCount; size *= 2)
+        ;
+    table = malloc(size * sizeof(Node *));
+    merged = calloc(ruleCount + 1, sizeof(Node *));
+    do
+    {
+        changed = 0;
+        memset(table, 0, size * sizeof(Node *));
+        for (r = rules; r; r = r->rule.next)
+        {
+            if (!r->rule.expression || r->rule.variables
+                || ((RuleInlined | RuleDead) & r->rule.flags))
+                continue;
+            for (h = Node_hash(r->rule.expression) & (size - 1); (s = table[h]);
+                 h = (h + 1) & (size - 1))
+                if (Node_equal(s->rule.expression, r->rule.expression))
+                    break;
+            if (!s)
+                table[h] = r;
+            else if (Rule_removable(r) || Rule_removable(s))
+            {
+                // keep the one that must have a function of its own.
+                if (!Rule_removable(r))
+                    table[h] = r, r = s, s = table[h];
+                r->rule.flags |= RuleDead;
+                merged[r->rule.id] = s;
+                rewrote(OptMergeRules);
+                changed = 1;
+            }
+        }
+        for (r = rules; r; r = r->rule.next)
+            if (r->rule.expression && !(RuleDead & r->rule.flags))
+                Node_redirect(r->rule.expression, merged);
+    } while (changed);
+    free(merged);
+    free(table);
+}
+
+
+/*
+ * Dead rule elimination: only rules that can be reached from start or
+ * from an entry point declared with -e keep their functions.  The others
+ * are marked RuleDead.  Their actions are generated only if an inlined
+ * copy still schedules them (see Rule_compile_c).  A removed rule that
+ * no other removed rule calls might be meant for YYPARSEFROM, which used
+ * to work without -e, so it is reported.
+ */
+
+static void Rule_reach(Node * rule);
+
+static void Node_reach(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        Rule_reach(node->name.rule);
+        break;
 
-        // now run through a second time, optimizing any children.
+    case Alternate:
+    case Sequence:
         for (n = node->alternate.first; n; n = n->any.next)
-            optimize(n);
+            Node_reach(n);
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        Node_reach(node->query.element);
         break;
     }
+}
+
+static void Rule_reach(Node * rule)
+{
+    if (RuleReached & rule->rule.flags)
+        return;
+    rule->rule.flags |= RuleReached;
+    if (rule->rule.expression)
+        Node_reach(rule->rule.expression);
+}
+
+static void reportDeadRule(Node * rule)
+{
+    fprintf(stderr, "rule '%s' cannot be reached from '%s' and is not generated"
+            " (name it with -e to pass it to yyparsefrom)\n",
+            rule->rule.name, start->rule.name);
+    Rule_reach(rule);
+}
+
+static void pruneRules(Node * rules)
+{
+    Node **removed, *r;
 
+    char *called;
+
+    int id;
+
+    if (!optimizeEnabled(OptDeadRules) || !start)
+        return;
+    for (r = rules; r; r = r->rule.next)
+        if (r == start || (RuleEntry & r->rule.flags))
+            Rule_reach(r);
+    removed = calloc(ruleCount + 1, sizeof(Node *));
+    called = calloc(ruleCount + 1, 1);
+    for (r = rules; r; r = r->rule.next)
+    {
+        if (!(RuleReached & r->rule.flags))
+        {
+            // merged and inlined rules already have no function
+            if (!((RuleDead | RuleInlined) & r->rule.flags) && r->rule.expression)
+            {
+                removed[r->rule.id] = r;
+                rewrote(OptDeadRules);
+            }
+            r->rule.flags |= RuleDead;
+        }
+        r->rule.flags &= ~RuleReached;
+    }
+
+    // report the removed rules that no removed rule calls, then the first
+    // rule (in order of appearance) of each cycle they do not reach
+    for (id = 1; id <= ruleCount; ++id)
+        if (removed[id])
+            Node_reach(removed[id]->rule.expression);
+    for (r = rules; r; r = r->rule.next)
+    {
+        called[r->rule.id] = !!(RuleReached & r->rule.flags);
+        r->rule.flags &= ~RuleReached;
+    }
+    for (id = 1; id <= ruleCount; ++id)
+        if (removed[id] && !called[id])
+            reportDeadRule(removed[id]);
+    for (id = 1; id <= ruleCount; ++id)
+        if (removed[id] && !(RuleReached & removed[id]->rule.flags))
+            reportDeadRule(removed[id]);
+    for (r = rules; r; r = r->rule.next)
+        r->rule.flags &= ~RuleReached;
+    free(called);
+    free(removed);
+}
+
+/*
+ * left-factor alternates: A B / A C -> A ( B / C )
+ *
+ * Matching A again after B fails gives the same result as keeping the
+ * first match, as long as A schedules no actions, sets no variables and
+ * runs no predicates other than < and > (actions in rules it calls are
+ * only scheduled, and are discarded on backtracking either way).
+ * Backtracking does not restore the text markers set by < and > though,
+ * so nothing is factored when one remainder can move them and a later
+ * one reads the text.  Nor is anything factored when A can move them and
+ * a remainder other than the last can too: after that remainder fails,
+ * matching A again would have moved them back.
+ */
+static int Node_factorable(Node * node)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Action:
+        return 0;
+
+    case Predicate:
+        return !strcmp(node->predicate.text, "YY_BEGIN")
+            || !strcmp(node->predicate.text, "YY_END");
+
+    case Name:
+        return !node->name.variable && !(RulePredicates & node->name.rule->rule.flags);
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            if (!Node_factorable(n))
+                return 0;
+        return 1;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_factorable(node->query.element);
+    }
+    return 1;
+}
+
+
+/*
+ * Can node move the text markers (set) or read the text (!set)?
+ */
+static int Node_usesText(Node * node, int set)
+{
+    Node *n;
+
+    switch (node->type)
+    {
+    case Name:
+        n = node->name.rule;
+        if (!n->rule.expression || (RuleReached & n->rule.flags))
+            return 0;
+        n->rule.flags |= RuleReached;
+        return Node_usesText(n->rule.expression, set);
+
+    case Action:
+        return !set && node->action.usesText;
+
+    case Predicate:
+        if (set)
+            return !strcmp(node->predicate.text, "YY_BEGIN")
+                || !strcmp(node->predicate.text, "YY_END");
+        return node->predicate.usesText;
+
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = n->any.next)
+            if (Node_usesText(n, set))
+                return 1;
+        return 0;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_usesText(node->query.element, set);
+    }
+    return 0;
+}
+
+/*
+ * the i-th element of an alternative (which is a sequence or a single
+ * element); the elements after it follow through any.next.
+ */
+static Node *element(Node * alt, int i)
+{
+    Node *n;
+
+    if (Sequence != alt->type)
+        return i ? NULL : alt;
+    for (n = alt->sequence.first; n && i; n = n->any.next)
+        --i;
+    return n;
+}
+
+static int restUsesText(Node * alt, int k, int set)
+{
+    Node *n, *r;
+
+    int result = 0;
+
+    for (n = element(alt, k); n && !result; n = n->any.next)
+        result = Node_usesText(n, set);
+    for (r = rules; r; r = r->rule.next)
+        r->rule.flags &= ~RuleReached;
+    return result;
+}
+
+/*
+ * Can the first k elements of an alternative move the text markers?
+ */
+static int prefixMovesText(Node * alt, int k)
+{
+    Node *n, *r;
+
+    int result = 0;
+
+    for (n = element(alt, 0); k-- && !result; n = n->any.next)
+        result = Node_usesText(n, 1);
+    for (r = rules; r; r = r->rule.next)
+        r->rule.flags &= ~RuleReached;
+    return result;
+}
+
+void optimizeAlternateFactor(Node * node)
+{
+    Node *alt, *nextAlt, *prevAlt = NULL;
+
+    assert(node);
+    assert(node->type == Alternate);
+
+    for (alt = node->alternate.first; alt; alt = nextAlt)
+    {
+        Node *first = element(alt, 0), *end, *n, *e, *f;
+
+        Node **prefix, *inner = NULL, *newNode;
+
+        int count = 1, k, i, written, moved, optional;
+
+        nextAlt = alt->any.next;
+        if (!first || !Node_factorable(first))
+        {
+            prevAlt = alt;
+            continue;
+        }
+
+        // the following alternatives that start with the same element
+        for (end = nextAlt; end && (f = element(end, 0)) && Node_equal(first, f);
+             end = end->any.next)
+            ++count;
+        if (count < 2)
+        {
+            prevAlt = alt;
+            continue;
+        }
+
+        // the longest prefix they all share
+        for (k = 1; (e = element(alt, k)) && Node_factorable(e); ++k)
+        {
+            for (n = nextAlt; n != end; n = n->any.next)
+                if (!(f = element(n, k)) || !Node_equal(e, f))
+                    break;
+            if (n != end)
+                break;
+        }
+
+        // a remainder that fails after moving the markers leaves them
+        // moved, where matching the prefix again would have reset them.
+        moved = prefixMovesText(alt, k);
+        written = 0;
+        for (n = alt; n != end; n = n->any.next)
+        {
+            if (written && restUsesText(n, k, 0))
+                break;
+            if (moved && n->any.next != end && restUsesText(n, k, 1))
+                break;
+            written |= restUsesText(n, k, 1);
+        }
+        if (n != end)
+        {
+            prevAlt = alt;
+            continue;
+        }
+
+        prefix = malloc(k * sizeof(Node *));
+        for (i = 0; i < k; ++i)
+            prefix[i] = element(alt, i);
+
+        // the remainders become an alternate; one that is empty always
+        // matches, so it ends the list and makes the alternate optional.
+        optional = 0;
+        for (n = alt; n != end; n = nextAlt)
+        {
+            Node *rest = element(n, k);
+
+            nextAlt = n->any.next;
+            if (optional)
+                continue;
+            if (!rest)
+                optional = 1;
+            else if (rest->any.next)
+            {
+                // reuse the sequence for what is left of it
+                n->sequence.first = rest;
+                rest = n;
+            }
+            if (rest)
+            {
+                rest->any.next = NULL;
+                inner = inner ? Alternate_append(inner, rest) : rest;
+            }
+        }
+        if (optional && inner)
+            inner = makeQuery(inner);
+
+        for (i = 0; i < k; ++i)
+            prefix[i]->any.next = NULL;
+        newNode = makeSequence(prefix[0]);
+        for (i = 1; i < k; ++i)
+            Sequence_append(newNode, prefix[i]);
+        // the new alternate is optimized in the next round.
+        if (inner)
+            Sequence_append(newNode, inner);
+        if (newNode->sequence.first == newNode->sequence.last)
+        {
+            Node *only = newNode->sequence.first;
+
+            freeNode(newNode);
+            newNode = only;
+        }
+        free(prefix);
+
+        if (prevAlt)
+            prevAlt->any.next = newNode;
+        else
+            node->alternate.first = newNode;
+        newNode->any.next = end;
+        prevAlt = newNode;
+        nextAlt = end;
+        rewrote(OptLeftFactor);
+    }
+    node->alternate.last = prevAlt;
+}
+
+/*
+ * combine adjacent literals in a sequence: 'a' "bc" -> "abc"
+ */
+static int isLiteral(Node * node)
+{
+    return node && (Character == node->type
+                    || (String == node->type && node->string.rawString->length));
+}
+
+static int isCaseless(Node * node)
+{
+    return String == node->type && node->string.rawString->caseless;
+}
+
+/*
+ * A caseless literal can only absorb one that has no letters, and vice
+ * versa.
+ */
+static int canMerge(Node * a, Node * b)
+{
+    Node *exact;
+
+    if (isCaseless(a) == isCaseless(b))
+        return 1;
+    exact = isCaseless(a) ? b : a;
+    if (Character == exact->type)
+        return !isalpha((unsigned char)exact->character.cValue);
+    return !RawString_hasLetters(exact->string.rawString);
+}
+
+static int literalBytes(Node * node, char *bytes)
+{
+    if (Character == node->type)
+    {
+        bytes[0] = node->character.cValue;
+        return 1;
+    }
+    memcpy(bytes, node->string.rawString->string, node->string.rawString->length);
+    return node->string.rawString->length;
+}
+
+void optimizeSequenceLiterals(Node * node)
+{
+    Node *n;
+
+    Node *prevNode = NULL;
+
+    Node *nextNode = NULL;
+
+    assert(node);
+    assert(node->type == Sequence);
+
+    n = node->sequence.first;
+    while (n)
+    {
+        nextNode = n->any.next;
+
+        if (isLiteral(n) && isLiteral(nextNode) && canMerge(n, nextNode))
+        {
+            Node *newNode;
+
+            char *bytes, *text;
+
+            int length;
+
+            bytes = malloc(2 + (String == n->type ? n->string.rawString->length : 0)
+                           + (String == nextNode->type ? nextNode->string.rawString->length : 0));
+            length = literalBytes(n, bytes);
+            length += literalBytes(nextNode, bytes + length);
+            text = escape(bytes, length);
+            newNode = isCaseless(n) || isCaseless(nextNode) ? makeCaselessString(text) : makeString(text);
+            free(text);
+            free(bytes);
+
+            // newNode is inserted, both n and nextNode are deleted.
+            if (prevNode)
+                prevNode->any.next = newNode;
+            else
+                node->sequence.first = newNode;
+            newNode->any.next = nextNode->any.next;
+
+            freeNode(n);
+            freeNode(nextNode);
+            n = newNode;
+            rewrote(OptMergeLiterals);
+
+            continue;
+        }
+
+        prevNode = n;
+        n = nextNode;
+    }
+    node->sequence.last = prevNode;
+}
+
+/*
+ * Lookahead fusion: a lookahead on one character followed by something
+ * that matches one character tests the same character twice, so
+ *
+ *   !A B  ->  [B and not A]        &A B  ->  [B and A]
+ *
+ * where A is a character or class and B a character, class or dot.  The
+ * save, sub-match and restore of the lookahead disappear, and ( !'}' . )*
+ * becomes a repetition of a class that can be matched as a span.  More
+ * generally &X X is just X when X has no side effects.
+ */
+
+static int singleCharacter(Node * node, unsigned char bits[])
+{
+    memset(bits, 0, 32);
+    switch (node->type)
+    {
+    case Character:
+        charClassSet(bits, (unsigned char)node->character.cValue);
+        return 1;
+
+    case Class:
+        memcpy(bits, node->cclass.bits, 32);
+        return 1;
+
+    case Dot:
+        memset(bits, 255, 32);
+        return 1;
+    }
+    return 0;
+}
+
+void optimizeSequenceLookahead(Node * node)
+{
+    Node *n, *nextNode, *prevNode = NULL;
+
+    unsigned char peek[32], bits[32];
+
+    int c;
+
+    assert(node);
+    assert(node->type == Sequence);
+
+    n = node->sequence.first;
+    while (n && (nextNode = n->any.next))
+    {
+        if ((PeekNot == n->type || PeekFor == n->type) && Dot != n->peekFor.element->type
+            && singleCharacter(n->peekFor.element, peek) && singleCharacter(nextNode, bits))
+        {
+            if (PeekNot == n->type)
+                for (c = 0; c < 32; ++c)
+                    peek[c] = ~peek[c];
+            charClassAnd(bits, peek);
+            for (c = 0; c < 32 && !bits[c]; ++c)
+                ;
+            // leave a sequence that can never match as it is.
+            if (c < 32)
+            {
+                Node *newNode = makeClass(NULL);
+
+                memcpy(newNode->cclass.bits, bits, 32);
+                if (prevNode)
+                    prevNode->any.next = newNode;
+                else
+                    node->sequence.first = newNode;
+                newNode->any.next = nextNode->any.next;
+                freeNode(n->peekFor.element);
+                freeNode(n);
+                freeNode(nextNode);
+                rewrote(OptLookahead);
+
+                // the new class may fuse with a lookahead before it.
+                n = prevNode ? prevNode : newNode;
+                prevNode = NULL;
+                for (nextNode = node->sequence.first; nextNode != n; nextNode = nextNode->any.next)
+                    prevNode = nextNode;
+                continue;
+            }
+        }
+        else if (PeekFor == n->type && Node_equal(n->peekFor.element, nextNode)
+                 && Node_factorable(nextNode))
+        {
+            if (prevNode)
+                prevNode->any.next = nextNode;
+            else
+                node->sequence.first = nextNode;
+            freeNode(n);
+            rewrote(OptLookahead);
+            n = nextNode;
+            continue;
+        }
+        prevNode = n;
+        n = nextNode;
+    }
+    node->sequence.last = n ? n : prevNode;
+}
+
+/*
+ * a sequence of one element (often left behind by the merge above) is
+ * just that element.
+ */
+static Node *unwrapSequence(Node * node)
+{
+    Node *element;
+
+    if (!optimizeEnabled(OptMergeLiterals) || Sequence != node->type
+        || !node->sequence.first || node->sequence.first != node->sequence.last)
+        return node;
+    element = node->sequence.first;
+    element->any.next = node->any.next;
+    freeNode(node);
+    return element;
+}
+
+
+/*
+ * Canonicalization rewrites expressions into a normal form that the
+ * other passes can work on more often:
+ *
+ *   ( A / ( B / C ) ) -> ( A / B / C )    A ( B C ) -> A B C
+ *   ( A )            -> A                 "a" [b]   -> 'a' 'b'
+ *   [\000-\377]      -> .
+ *   X X*             -> X+                X* X*     -> X*
+ *   X+ X*            -> X+                !!X       -> &X
+ *   &!X, !&X         -> !X                &&X       -> &X
+ *   ( X? )?          -> X?                ( X+ )+   -> X+
+ *   ( X* )?, ( X+ )? -> X*                ( X+ )*   -> X*
+ *
+ * A repetition of something that can always match without moving, such
+ * as ( X? )* or ( X* )+, never ends; it becomes X*.  Rewrites that try X
+ * once more at a position where it has just failed are only made when X
+ * has no side effects (see Node_factorable).
+ */
+
+static void Node_free(Node * node)
+{
+    Node *n, *next;
+
+    switch (node->type)
+    {
+    case Alternate:
+    case Sequence:
+        for (n = node->alternate.first; n; n = next)
+        {
+            next = n->any.next;
+            Node_free(n);
+        }
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        Node_free(node->query.element);
+        break;
+    }
+    freeNode(node);
+}
+
+// node takes the place of old (and of its next).
+static Node *replace(Node * old, Node * node)
+{
+    node->any.next = old->any.next;
+    freeNode(old);
+    rewrote(OptCanonicalize);
+    return node;
+}
+
+static Node *makeCharacter(int c)
+{
+    char byte = c, *text = escape(&byte, 1);
+
+    Node *node = makeString(text);
+
+    free(text);
+    return node;
+}
+
+// splice the children of nested alternates or sequences into node.
+static void flatten(Node * node)
+{
+    Node **link, *n, *last = NULL;
+
+    for (link = &node->alternate.first; (n = *link); link = &last->any.next)
+    {
+        if (n->type == node->type && n->alternate.first)
+        {
+            *link = n->alternate.first;
+            n->alternate.last->any.next = n->any.next;
+            last = n->alternate.last;
+            freeNode(n);
+            rewrote(OptCanonicalize);
+        }
+        else
+            last = n;
+    }
+    node->alternate.last = last;
+}
+
+// X X* -> X+, X* X* -> X*, X+ X* -> X+
+static void foldRepetitions(Node * node)
+{
+    Node *n, *next, *prev = NULL;
+
+    for (n = node->sequence.first; n && (next = n->any.next);)
+    {
+        if (Star == next->type && Node_equal(n, next->star.element))
+        {
+            Node *after = next->any.next;
+
+            next->any.next = NULL;
+            Node_free(next);
+            n->any.next = NULL;
+            next = makePlus(n);
+            next->any.next = after;
+            if (prev)
+                prev->any.next = next;
+            else
+                node->sequence.first = next;
+            n = next;
+            rewrote(OptCanonicalize);
+            continue;
+        }
+        if (Star == next->type && (Star == n->type || Plus == n->type)
+            && Node_equal(n->star.element, next->star.element)
+            && Node_factorable(next->star.element))
+        {
+            n->any.next = next->any.next;
+            next->any.next = NULL;
+            Node_free(next);
+            rewrote(OptCanonicalize);
+            continue;
+        }
+        prev = n;
+        n = next;
+    }
+    node->sequence.last = n ? n : prev;
+}
+
+static Node *canonicalize(Node * node)
+{
+    Node *element;
+
+    int c, count;
+
+    switch (node->type)
+    {
+    case String:
+        if (1 == node->string.rawString->length && !node->string.rawString->caseless)
+            return replace(node, makeCharacter((unsigned char)node->string.rawString->string[0]));
+        break;
+
+    case Class:
+        for (c = count = 0; c < 256; ++c)
+            count += !!charClassIsSet(node->cclass.bits, c);
+        if (256 == count)
+            return replace(node, makeDot());
+        if (1 == count)
+        {
+            for (c = 0; !charClassIsSet(node->cclass.bits, c); ++c)
+                ;
+            return replace(node, makeCharacter(c));
+        }
+        break;
+
+    case Alternate:
+        flatten(node);
+        if (node->alternate.first && node->alternate.first == node->alternate.last)
+            return replace(node, node->alternate.first);
+        break;
+
+    case Sequence:
+        flatten(node);
+        foldRepetitions(node);
+        if (node->sequence.first && node->sequence.first == node->sequence.last)
+            return replace(node, node->sequence.first);
+        break;
+
+    case PeekFor:
+    case PeekNot:
+        element = node->peekFor.element;
+        if (PeekFor == element->type || PeekNot == element->type)
+        {
+            // &&X, !!X -> &X;  &!X, !&X -> !X
+            if (node->type == element->type)
+                element->type = PeekFor;
+            else
+                element->type = PeekNot;
+            return replace(node, element);
+        }
+        break;
+
+    case Query:
+    case Star:
+    case Plus:
+        element = node->query.element;
+        if (Query != element->type && Star != element->type && Plus != element->type)
+            break;
+        if (node->type == element->type && Star != node->type)
+        {
+            // ( X? )? -> X?, but ( X+ )+ tries X again where it failed
+            if (Query == node->type || Node_factorable(element->plus.element))
+                return replace(node, element);
+            break;
+        }
+        if (Star == node->type && Plus == element->type
+            && !Node_factorable(element->plus.element))
+            break;
+        // ( X* )?, ( X+ )?, ( X+ )* -> X*, and the loops that never end
+        element->type = Star;
+        return replace(node, element);
+    }
+    return node;
+}
+
+/*
+ * The pass manager: a visitor walks the whole grammar bottom up, so
+ * every node is rewritten after its children, and answers the node that
+ * takes its place.  A rewrite can give the nodes below it something new
+ * to do (left factoring makes a new alternate of the remainders), so the
+ * walk is repeated until a round rewrites nothing.
+ */
+
+typedef Node *(*Visitor) (Node * node);
+
+static Node *Node_visit(Node * node, Visitor visitor)
+{
+    Node **link, *last;
+
+    switch (node->type)
+    {
+    case Rule:
+        if (node->rule.expression)
+            node->rule.expression = Node_visit(node->rule.expression, visitor);
+        break;
+
+    case Alternate:
+    case Sequence:
+        last = NULL;
+        for (link = &node->alternate.first; *link; link = &last->any.next)
+            last = *link = Node_visit(*link, visitor);
+        node->alternate.last = last;
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        node->query.element = Node_visit(node->query.element, visitor);
+        break;
+    }
+    return visitor(node);
+}
+
+static Node *optimizeNode(Node * node)
+{
+    if (optimizeEnabled(OptCanonicalize))
+        node = canonicalize(node);
+    switch (node->type)
+    {
+    case Sequence:
+        if (optimizeEnabled(OptLookahead))
+            optimizeSequenceLookahead(node);
+        if (optimizeEnabled(OptMergeLiterals))
+            optimizeSequenceLiterals(node);
+        node = unwrapSequence(node);
+        break;
+
+    case Alternate:
+        // the children are done: merging their literals can turn an
+        // alternative like '%' '{' into the string "%{" for the passes below.
+        if (optimizeEnabled(OptLeftFactor))
+            optimizeAlternateFactor(node);
+
+        // todo -- pass in/return a pair of start/end nodes
+        // to simplify the insertion/removal logic
+        
+        if (optimizeEnabled(OptAlternateClass))
+            optimizeAlternateClass(node);
+        if (optimizeEnabled(OptAlternateStrings))
+        {
+            optimizeAlternateStrings(node);
+            // the table relies on unreachable strings having been removed
+            if (optimizeEnabled(OptStringTable))
+                optimizeAlternateStringTable(node);
+        }
+        break;
+
+    default:
+        return node;
+    }
+    // the passes above can leave a single element behind
+    if (optimizeEnabled(OptCanonicalize))
+        node = canonicalize(node);
+    return node;
+}
+
+void optimize(Node * rules)
+{
+    Node *r;
+
+    int count;
+
+    analyze(rules);
+    inlineRules(rules);
+    do
+    {
+        count = rewrites();
+        ++rounds;
+        for (r = rules; r; r = r->rule.next)
+            Node_visit(r, optimizeNode);
+    } while (rewrites() != count);
+    mergeRules(rules);
+    pruneRules(rules);
 }
@@ -1,8 +1,47 @@
 #ifndef __OPTIMIZE_H__
 #define __OPTIMIZE_H__
 
+#include <stdio.h>
+
 union Node;
 
-void optimize(union Node *);
+/*
+ * Passes that can be switched on and off with -O<level> and -f[no-]<name>.
+ */
+enum
+{
+    OptInline,                  /* splice small rules into their callers */
+    OptMergeLiterals,           /* merge adjacent characters and strings in sequences */
+    OptAlternateClass,          /* merge adjacent class and character alternates */
+    OptAlternateStrings,        /* drop string alternates that can never match */
+    OptStringTable,             /* switch on the first character of string alternates */
+    OptClassTests,              /* inline range tests and shared class tables */
+    OptSpan,                    /* match repeated characters and classes with span functions */
+    OptScan,                    /* compile ( !X . )* as a search for X */
+    OptLeftFactor,              /* A B / A C -> A ( B / C ) */
+    OptDispatch,                /* switch on FIRST sets to choose between alternates */
+    OptLiteralRuns,             /* one length check for a run of fixed-length literals */
+    OptMergeRules,              /* generate one function for rules with identical expressions */
+    OptDeadRules,               /* generate no functions for rules that cannot be reached */
+    OptLookahead,               /* !A . -> [^A], &X X -> X */
+    OptCanonicalize,            /* flatten, unwrap and fold expressions into a normal form */
+    OptCount
+};
+
+extern int optimizeLevel;
+
+int optimizeEnabled(int pass);
+
+int optimizeOption(const char *option);
+
+void optimizeUsage(FILE *stream);
+
+char *escape(const char *cp, int length);
+
+int Node_accepts(union Node *node);
+
+void optimize(union Node *rules);
+
+void optimizeStatistics(FILE *stream);
 
 #endif
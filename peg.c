@@ -18,6 +18,7 @@
 
 #include "tree.h"
 #include "version.h"
+#include "optimize.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,13 +37,25 @@ static char *fileName = 0;
 
 void yyerror(char *message);
 
-#define YY_INPUT(buf, result, max)			\
-{							\
-  int c= getc(input);					\
-  if ('\n' == c || '\r' == c) ++lineNumber;		\
-  result= (EOF == c) ? 0 : (*(buf)= c, 1);		\
+/*
+ * Input is read a line at a time so that lineNumber still tracks the
+ * furthest text the parser has looked at.
+ */
+static int readLine(char *buf, int max)
+{
+    int length, i;
+
+    if (!fgets(buf, max, input))
+        return 0;
+    length = strlen(buf);
+    for (i = 0; i < length; ++i)
+        if ('\n' == buf[i] || '\r' == buf[i])
+            ++lineNumber;
+    return length;
 }
 
+#define YY_INPUT(buf, result, max)	result= readLine((buf), (max))
+
 #define YY_LOCAL(T)	static T
 #define YY_RULE(T)	static T
 
@@ -86,8 +99,15 @@ static void usage(char *name)
     version(name);
     fprintf(stderr, "usage: %s [<option>...] [<file>...]\n", name);
     fprintf(stderr, "where <option> can be\n");
+    fprintf(stderr, "  -e <rule>   generate <rule> as an entry point for yyparsefrom()\n");
+    fprintf(stderr, "  -f<pass>    run <pass>, or skip it with -fno-<pass>, where <pass> is one of\n");
+    optimizeUsage(stderr);
     fprintf(stderr, "  -h          print this help information\n");
+    fprintf(stderr, "  -m          memoize rule results (packrat parsing)\n");
     fprintf(stderr, "  -o <ofile>  write output to <ofile>\n");
+    fprintf(stderr, "  -O<level>   run the optimization passes of <level> 0, 1 or 2 (default 2)\n");
+    fprintf(stderr, "  -p          count calls, failures and backtracking per rule\n");
+    fprintf(stderr, "  -r          generate a reentrant parser (see YY_CTX_LOCAL)\n");
     fprintf(stderr, "  -v          be verbose\n");
     fprintf(stderr, "  -V          print version number and exit\n");
     fprintf(stderr, "if no <file> is given, input is read from stdin\n");
@@ -106,18 +126,43 @@ int main(int argc, char **argv)
     lineNumber = 1;
     fileName = "<stdin>";
 
-    while (-1 != (c = getopt(argc, argv, "Vho:v")))
+    while (-1 != (c = getopt(argc, argv, "O:Ve:f:hmo:prv")))
     {
         switch (c)
         {
+        case 'O':
+            if (!*optarg || optarg[strspn(optarg, "0123456789")])
+            {
+                fprintf(stderr, "%s: bad optimization level '%s'\n", argv[0], optarg);
+                exit(1);
+            }
+            optimizeLevel = atoi(optarg);
+            break;
+
         case 'V':
             version(basename(argv[0]));
             exit(0);
 
+        case 'e':
+            Rule_beEntry(findRule(optarg));
+            break;
+
+        case 'f':
+            if (!optimizeOption(optarg))
+            {
+                fprintf(stderr, "%s: unknown optimization '%s'\n", argv[0], optarg);
+                exit(1);
+            }
+            break;
+
         case 'h':
             usage(basename(argv[0]));
             break;
 
+        case 'm':
+            memoizeFlag = 1;
+            break;
+
         case 'o':
             if (!(output = fopen(optarg, "w")))
             {
@@ -126,6 +171,14 @@ int main(int argc, char **argv)
             }
             break;
 
+        case 'p':
+            profileFlag = 1;
+            break;
+
+        case 'r':
+            reentrantFlag = 1;
+            break;
+
         case 'v':
             verboseFlag = 1;
             break;
@@ -100,11 +100,11 @@ unsigned char *charClassMake(const char *cclass, unsigned char bits[])
         memset(bits, 0, 32);
         set = charClassSet;
     }
-    while ((c = *cclass++))
+    while ((c = (unsigned char)*cclass++))
     {
         if ('-' == c && *cclass && prev >= 0)
         {
-            for (c = *cclass++; prev <= c; ++prev)
+            for (c = (unsigned char)*cclass++; prev <= c; ++prev)
                 set(bits, prev);
             prev = -1;
         }
@@ -165,3 +165,34 @@ char *charClassToString(unsigned char bits[])
 
     return string;
 }
+
+/*
+ * The same set transposed for lookup by nibble: bit (c >> 4) & 7 of
+ * byte (c >> 7) * 16 + (c & 15) is set if c is in the class.  Two
+ * 16-byte shuffles can then test sixteen characters at once.
+ */
+char *charClassToNibbleString(unsigned char bits[])
+{
+    static char string[256];
+
+    unsigned char nibbles[32];
+
+    int c;
+
+    char *ptr;
+
+
+    memset(nibbles, 0, sizeof(nibbles));
+    for (c = 0; c < 256; ++c)
+    {
+        if (charClassIsSet(bits, c))
+            nibbles[(c >> 7) * 16 + (c & 15)] |= 1 << ((c >> 4) & 7);
+    }
+
+    for (c = 0, ptr = string; c < 32; ++c)
+    {
+        ptr += sprintf(ptr, "\\x%02x", nibbles[c]);
+    }
+
+    return string;
+}
@@ -36,4 +36,6 @@ unsigned char *charClassMake(const char *cclass, unsigned char bits[]);
 
 char *charClassToString(unsigned char bits[]);
 
+char *charClassToNibbleString(unsigned char bits[]);
+
 #endif
@@ -24,6 +24,7 @@
 
 #include "tree.h"
 #include "set.h"
+#include "optimize.h"
 
 Node *actions = 0;
 
@@ -100,10 +101,13 @@ struct RawString *unescape(const char *cp)
 
     int xval = 0;
 
+    int digits = 0;
+
     char c;
 
     l = strlen(cp);
     out = (struct RawString *)malloc(sizeof(struct RawString) + l + 1);
+    out->caseless = 0;
     l = 0;
 
     while ((c = *cp++))
@@ -126,6 +130,7 @@ struct RawString *unescape(const char *cp)
                 st = 2;
                 // octal escape
                 xval = c - '0';
+                digits = 1;
                 break;
             case 'x':
                 // hex escape
@@ -166,8 +171,8 @@ struct RawString *unescape(const char *cp)
 
         if (st == 2)
         {
-            // octal escape.
-            if (c >= '0' && c <= '7')
+            // octal escape, at most three digits as in C.
+            if (c >= '0' && c <= '7' && digits < 3)
             {
                 int tmp;
 
@@ -175,6 +180,7 @@ struct RawString *unescape(const char *cp)
                 if (tmp <= 255)
                 {
                     xval = tmp;
+                    ++digits;
                     continue;
                 }
             }
@@ -270,6 +276,16 @@ Node *beginRule(Node * rule)
     return thisRule = rule;
 }
 
+/*
+ * An entry point is generated (to be passed to YYPARSEFROM) even when
+ * start does not reach it.
+ */
+Node *Rule_beEntry(Node * rule)
+{
+    rule->rule.flags |= RuleUsed | RuleEntry;
+    return rule;
+}
+
 void Rule_setExpression(Node * node, Node * expression)
 {
     assert(node);
@@ -341,6 +357,55 @@ Node *makeString(char *text)
     return node;
 }
 
+/*
+ * Add the characters that can begin a (non-empty) string to first.
+ */
+void RawString_first(struct RawString *string, unsigned char first[])
+{
+    int c = (unsigned char)string->string[0];
+
+    charClassSet(first, c);
+    if (string->caseless)
+        charClassSet(first, toupper(c));
+}
+
+/*
+ * A case-insensitive string.  A single letter becomes the class of both
+ * its cases, and a string without letters is an ordinary string.
+ */
+Node *makeCaselessString(char *text)
+{
+    Node *node;
+
+    struct RawString *string = unescape(text);
+
+    int letters = 0, i;
+
+    for (i = 0; i < string->length; ++i)
+        if (isalpha((unsigned char)string->string[i]))
+        {
+            string->string[i] = tolower((unsigned char)string->string[i]);
+            ++letters;
+        }
+    if (!letters)
+    {
+        free(string);
+        return makeString(text);
+    }
+    if (1 == string->length)
+    {
+        char cases[3] = { string->string[0], toupper((unsigned char)string->string[0]), 0 };
+
+        free(string);
+        return makeClass(cases);
+    }
+    string->caseless = 1;
+    node = newNode(String);
+    node->string.value = escape(string->string, string->length);
+    node->string.rawString = string;
+    return node;
+}
+
 Node *makeClass(char *text)
 {
     Node *node = newNode(Class);
@@ -351,6 +416,26 @@ Node *makeClass(char *text)
     return node;
 }
 
+/*
+ * Does the C code in text refer to the identifiers yytext or yyleng?
+ * If not, the matched text need not be copied out of the input buffer
+ * before the code runs.
+ */
+static int usesText(char *text)
+{
+    char *ptr;
+
+    for (ptr = text; (ptr = strstr(ptr, "yy")); ptr += 2)
+    {
+        if (ptr > text && ('_' == ptr[-1] || isalnum((unsigned char)ptr[-1])))
+            continue;
+        if ((!strncmp(ptr, "yytext", 6) || !strncmp(ptr, "yyleng", 6))
+            && '_' != ptr[6] && !isalnum((unsigned char)ptr[6]))
+            return 1;
+    }
+    return 0;
+}
+
 Node *makeAction(char *text)
 {
     Node *node = newNode(Action);
@@ -363,6 +448,7 @@ Node *makeAction(char *text)
     node->action.text = strdup(text);
     node->action.list = actions;
     node->action.rule = thisRule;
+    node->action.id = actions ? actions->action.id + 1 : 1;
     actions = node;
     {
         char *ptr;
@@ -371,6 +457,7 @@ Node *makeAction(char *text)
             if ('$' == ptr[0] && '$' == ptr[1])
                 ptr[1] = ptr[0] = 'y';
     }
+    node->action.usesText = usesText(node->action.text);
     return node;
 }
 
@@ -379,6 +466,7 @@ Node *makePredicate(char *text)
     Node *node = newNode(Predicate);
 
     node->predicate.text = strdup(text);
+    node->predicate.usesText = usesText(text);
     return node;
 }
 
@@ -483,6 +571,185 @@ Node *makeStringTable(int count)
     return node;
 }
 
+/*
+ * Are two expressions structurally identical?
+ */
+int Node_equal(Node * a, Node * b)
+{
+    Node *m, *n;
+
+    if (a->type != b->type)
+        return 0;
+    switch (a->type)
+    {
+    case Name:
+        return a->name.rule == b->name.rule && a->name.variable == b->name.variable;
+
+    case Dot:
+        return 1;
+
+    case Character:
+        return a->character.cValue == b->character.cValue;
+
+    case String:
+        return a->string.rawString->length == b->string.rawString->length
+            && a->string.rawString->caseless == b->string.rawString->caseless
+            && !memcmp(a->string.rawString->string, b->string.rawString->string,
+                       a->string.rawString->length);
+
+    case Class:
+        return !memcmp(a->cclass.bits, b->cclass.bits, 32);
+
+    case Action:
+        return !strcmp(a->action.name, b->action.name);
+
+    case Predicate:
+        return !strcmp(a->predicate.text, b->predicate.text);
+
+    case Alternate:
+    case Sequence:
+        for (m = a->alternate.first, n = b->alternate.first; m && n;
+             m = m->any.next, n = n->any.next)
+            if (!Node_equal(m, n))
+                return 0;
+        return !m && !n;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        return Node_equal(a->query.element, b->query.element);
+
+    case StringTable:
+    {
+        int i;
+
+        if (a->table.value.count != b->table.value.count
+            || a->table.emptyString != b->table.emptyString
+            || a->table.caseless != b->table.caseless
+            || !a->table.bits != !b->table.bits
+            || (a->table.bits && memcmp(a->table.bits, b->table.bits, 32)))
+            return 0;
+        for (i = 0; i < a->table.value.count; ++i)
+        {
+            struct RawString *s = a->table.value.strings[i], *t = b->table.value.strings[i];
+
+            if (s->length != t->length || memcmp(s->string, t->string, s->length))
+                return 0;
+        }
+    }
+        return 1;
+    }
+    return 0;
+}
+
+static struct RawString *RawString_copy(struct RawString *string)
+{
+    size_t size = sizeof(struct RawString) + string->length + 1;
+
+    return memcpy(malloc(size), string, size);
+}
+
+/*
+ * Answer a deep copy of an expression.  Names still refer to the same
+ * rules and actions keep their names, so a copied action calls the same
+ * action function as the original.
+ */
+Node *Node_copy(Node * node)
+{
+    Node *copy, *n;
+
+    switch (node->type)
+    {
+    case Name:
+        copy = newNode(Name);
+        copy->name = node->name;
+        break;
+
+    case Dot:
+        copy = newNode(Dot);
+        break;
+
+    case Character:
+        copy = newNode(Character);
+        copy->character = node->character;
+        copy->character.value = strdup(node->character.value);
+        break;
+
+    case String:
+        copy = newNode(String);
+        copy->string = node->string;
+        copy->string.value = strdup(node->string.value);
+        copy->string.rawString = RawString_copy(node->string.rawString);
+        break;
+
+    case Class:
+        copy = newNode(Class);
+        copy->cclass = node->cclass;
+        if (node->cclass.value)
+            copy->cclass.value = (unsigned char *)strdup((char *)node->cclass.value);
+        break;
+
+    case Action:
+        // not added to the list of actions: the original's function serves both
+        copy = newNode(Action);
+        copy->action = node->action;
+        break;
+
+    case Predicate:
+        copy = newNode(Predicate);
+        copy->predicate = node->predicate;
+        break;
+
+    case Alternate:
+    case Sequence:
+        copy = Alternate == node->type ? newNode(Alternate) : newNode(Sequence);
+        for (n = node->alternate.first; n; n = n->any.next)
+        {
+            Node *e = Node_copy(n);
+
+            if (copy->alternate.last)
+                copy->alternate.last->any.next = e;
+            else
+                copy->alternate.first = e;
+            copy->alternate.last = e;
+        }
+        break;
+
+    case PeekFor:
+    case PeekNot:
+    case Query:
+    case Star:
+    case Plus:
+        // these all keep their only child in the same place
+        copy = _newNode(node->type, sizeof(struct Query));
+        copy->query.element = Node_copy(node->query.element);
+        break;
+
+    case StringTable:
+    {
+        int i;
+
+        copy = makeStringTable(node->table.value.count);
+        copy->table.value = node->table.value;
+        for (i = 0; i < node->table.value.count; ++i)
+            copy->table.value.strings[i] = RawString_copy(node->table.value.strings[i]);
+        copy->table.emptyString = node->table.emptyString;
+        copy->table.caseless = node->table.caseless;
+        if (node->table.bits)
+            copy->table.bits = memcpy(malloc(32), node->table.bits, 32);
+    }
+        break;
+
+    default:
+        fprintf(stderr, "\nNode_copy: illegal node type %d\n", node->type);
+        exit(1);
+    }
+    copy->any.next = 0;
+    return copy;
+}
+
 
 static Node *stack[1024];
 
@@ -556,7 +823,7 @@ static void Node_fprint(FILE * stream, Node * node)
         fprintf(stream, " '%s'", node->character.value);
         break;
     case String:
-        fprintf(stream, " \"%s\"", node->string.value);
+        fprintf(stream, " \"%s\"%s", node->string.value, node->string.rawString->caseless ? "i" : "");
         break;
     case Class:
         fprintf(stream, " [%s]", node->cclass.value);
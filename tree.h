@@ -30,11 +30,19 @@ enum
 {
     RuleUsed = 1 << 0,
     RuleReached = 1 << 1,
+    RuleNullable = 1 << 2,
+    RuleInlined = 1 << 3,
+    RuleThunks = 1 << 4,        /* matching the rule might push thunks */
+    RuleEntry = 1 << 5,         /* declared with -e as an entry point */
+    RuleDead = 1 << 6,          /* unreachable or merged: no function generated */
+    RuleInfallible = 1 << 7,    /* matching the rule always succeeds */
+    RulePredicates = 1 << 8,    /* matching the rule might run a predicate other than < and > */
 };
 
 
 struct RawString {
     int length;
+    int caseless; // letters are lower case and match either case
     char string[0];
 };
 
@@ -68,6 +76,7 @@ struct Rule
     Node *expression;
     int id;
     int flags;
+    unsigned char first[32];    /* characters that can begin a match */
 };
 
 struct Variable
@@ -125,6 +134,8 @@ struct Action
     Node *list;
     char *name;
     Node *rule;
+    int id;                     /* numbers all actions; shared by copies */
+    int usesText;               /* text mentions yytext or yyleng */
 };
 
 struct Predicate
@@ -132,6 +143,7 @@ struct Predicate
     int type;
     Node *next;
     char *text;
+    int usesText;               /* text mentions yytext or yyleng */
 };
 
 struct Alternate
@@ -191,6 +203,7 @@ struct StringTable
     Node *next;   
     unsigned char *bits; 
     int emptyString;
+    int caseless; // the strings match letters of either case
     struct StringArray value;
 };
 
@@ -234,6 +247,14 @@ extern int ruleCount;
 
 extern FILE *output;
 
+extern int memoizeFlag;
+
+extern int reentrantFlag;
+
+extern int profileFlag;
+
+extern int verboseFlag;
+
 void freeNode(Node * node);
 
 extern Node *makeRule(char *name);
@@ -246,6 +267,8 @@ extern void Rule_setExpression(Node * rule, Node * expression);
 
 extern Node *Rule_beToken(Node * rule);
 
+extern Node *Rule_beEntry(Node * rule);
+
 extern Node *makeVariable(char *name);
 
 extern Node *makeName(Node * rule);
@@ -255,6 +278,10 @@ extern Node *makeDot(void);
 // extern Node *makeCharacter(char *text);
 extern Node *makeString(char *text);
 
+extern Node *makeCaselessString(char *text);
+
+extern void RawString_first(struct RawString *string, unsigned char first[]);
+
 extern Node *makeClass(char *text);
 
 extern Node *makeAction(char *text);
@@ -281,6 +308,10 @@ extern Node *makePlus(Node * e);
 
 extern Node *makeStringTable(int count);
 
+extern Node *Node_copy(Node * node);
+
+extern int Node_equal(Node * a, Node * b);
+
 extern Node *push(Node * node);
 
 extern Node *top(void);